@@ -0,0 +1,13 @@
+QT -= gui
+
+# parity check of the SIMD json decoder against QJsonDocument (exit code = number of failed cases)
+TARGET = jsondecoder-parity
+CONFIG += console
+CONFIG -= app_bundle
+TEMPLATE = app
+
+SOURCES += main.cpp
+
+# Include telegrambotlib-qt with the SIMD json decoder
+CONFIG += telegrambot_simdjson
+include(../../telegrambotlib-qt.pri)
@@ -0,0 +1,109 @@
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QList>
+#include <QPair>
+#include "jsondecoder.h"
+
+// compares JsonDecoder::decodeObject with QJsonDocument::fromJson: valid documents have to result in the same object, invalid ones have to fail both
+int checkParity(QString name, QByteArray json)
+{
+    QJsonParseError qtError;
+    QJsonObject expected = QJsonDocument::fromJson(json, &qtError).object();
+    QJsonParseError error;
+    QJsonObject decoded = JsonDecoder::decodeObject(json, &error);
+
+    bool qtFailed = qtError.error != QJsonParseError::NoError;
+    bool failed = error.error != QJsonParseError::NoError;
+    if(qtFailed == failed && decoded == expected) return 0;
+    qWarning("%s - failed: QJsonDocument error %i, JsonDecoder error %i at %i\n%s", qPrintable(name), qtError.error, error.error, error.offset, json.constData());
+    return 1;
+}
+
+// invalid json which the decoder has to reject, independent of the leniency of the QJsonDocument version
+int checkRejected(QString name, QByteArray json, QJsonParseError::ParseError expectedError)
+{
+    QJsonParseError error;
+    JsonDecoder::decodeObject(json, &error);
+    if(error.error == expectedError) return 0;
+    qWarning("%s - failed: expected error %i, JsonDecoder error %i at %i", qPrintable(name), expectedError, error.error, error.offset);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    int failed = 0;
+
+    // api answers (getUpdates and the body of a webhook request)
+    QList<QPair<QString, QByteArray>> answers = {
+        { "getUpdates", R"({"ok":true,"result":[{"update_id":851793506,
+            "message":{"message_id":1290,"from":{"id":123456789,"is_bot":false,"first_name":"J\u00fcrgen","last_name":"M\u00fcller","username":"jm","language_code":"de"},
+            "chat":{"id":-1001234567890,"title":"Gruppe \ud83d\ude00","type":"supergroup"},"date":1700000000,"text":"/start@mybot hallo \"welt\"\n2. zeile",
+            "entities":[{"offset":0,"length":12,"type":"bot_command"}]}},
+            {"update_id":851793507,"callback_query":{"id":"4382bfdwdsb323b2d9","from":{"id":123456789,"is_bot":false,"first_name":"J"},
+            "message":{"message_id":1291,"chat":{"id":123456789,"type":"private"},"date":1700000001,"text":"men\u00fc",
+            "reply_markup":{"inline_keyboard":[[{"text":"<","callback_data":"menu..0"},{"text":">","callback_data":"menu..2"}]]}},"chat_instance":"-8374629384756","data":"menu..1"}},
+            {"update_id":851793508,"inline_query":{"id":"1234","from":{"id":1,"is_bot":false,"first_name":"\u4e2d\u6587"},"query":"caf\u00e9 \\ c:\\temp","offset":""}}]})" },
+        { "getUpdates (empty)", R"({"ok":true,"result":[]})" },
+        { "getUpdates (error)", R"({"ok":false,"error_code":409,"description":"Conflict: terminated by other getUpdates request; make sure that only one bot instance is running"})" },
+        { "webhook", R"({"update_id":851793509,"edited_message":{"message_id":1290,"from":{"id":123456789,"is_bot":false,"first_name":"Jürgen"},
+            "chat":{"id":123456789,"type":"private"},"date":1700000000,"edit_date":1700000100,"text":"ümlaut 😀 中文",
+            "photo":[{"file_id":"AgACAgIAAxkBAAIBZ2V","file_unique_id":"AQADzMkxG","file_size":1234,"width":90,"height":67}]}})" },
+        { "whitespace", " \r\n\t{ \"a\" : [ 1 , { } , [ ] , \"\" ] , \"b\" :\tnull }\r\n" },
+        { "array document", "[1,2,3]" }
+    };
+    for(const QPair<QString, QByteArray>& answer : answers) failed += checkParity(answer.first, answer.second);
+
+    // escapes and surrogate pairs
+    failed += checkParity("escapes", R"({"a":"\"\\\/\b\f\n\r\t","b":"\u0041\u00e9\u4e2d\uFFFD","c":"\u0000"})");
+    failed += checkParity("surrogate pair", R"({"a":"\ud83d\ude00","b":"x\uD83D\uDE00y\ud83d\ude01"})");
+    failed += checkParity("lone surrogates", R"({"a":"\ud800","b":"x\udc00y","c":"\ude00\ud83d","d":"\ud83d\u0041"})");
+    failed += checkParity("escaped keys", R"({"\"k\"":1,"\\":2,"\u00e9":3})");
+
+    // escape sequences at all positions of the 64 byte blocks (backslash runs and quotes across block borders)
+    for(int i = 0; i < 140; i++) {
+        QByteArray padding(i, 'a');
+        failed += checkParity(QString("block border %1").arg(i), "{\"p\":\"" + padding + "\\\\\\\"\\\\\",\"q\":\"" + padding + "\\\\\",\"r\":[1,{\"s\":\"\\u00e9\"}]}");
+    }
+
+    // numbers (integers up to 18 digits are exact, longer ones are doubles)
+    failed += checkParity("integers", R"({"a":0,"b":-1,"c":123456789,"d":-1001234567890,"e":999999999999999999,"f":-999999999999999999,"g":9007199254740993})");
+    failed += checkParity("19 digits", R"({"a":1234567890123456789,"b":9223372036854775807,"c":9999999999999999999,"d":-9999999999999999999})");
+    failed += checkParity("20 digits", R"({"a":12345678901234567890,"b":100000000000000000000})");
+    failed += checkParity("doubles", R"({"a":1.5,"b":-0.25,"c":1e3,"d":1E-3,"e":-1.25e+2,"f":0.1,"g":123456789.123456789,"h":1e308})");
+    failed += checkParity("number array", "{\"a\":[0,1,-1,2.5,1e2,-0]}");
+
+    // malformed documents
+    QList<QPair<QString, QByteArray>> malformed = {
+        { "empty", "" },
+        { "missing value", R"({"a":})" },
+        { "trailing comma", R"({"a":1,})" },
+        { "missing name separator", R"({"a" 1})" },
+        { "missing value separator", R"({"a":1 "b":2})" },
+        { "unterminated array", R"({"a":[1,2})" },
+        { "unterminated object", R"({"a":{"b":1})" },
+        { "unterminated string", R"({"a":"abc)" },
+        { "illegal literal", R"({"a":tru})" },
+        { "leading zero", R"({"a":01})" },
+        { "illegal escape", R"({"a":"\x"})" },
+        { "short unicode escape", R"({"a":"\u12"})" },
+        { "garbage at end", R"({"a":1} x)" },
+        { "scalar document", "1" },
+        { "truncated utf-8", "{\"a\":\"\xc3\"}" },
+        { "invalid utf-8", "{\"a\":\"abc\xff" "def\"}" },
+        { "overlong utf-8", "{\"a\":\"\xc0\xaf\"}" },
+        { "utf-8 surrogate", "{\"a\":\"\xed\xa0\x80\"}" },
+        { "utf-8 beyond U+10FFFF", "{\"a\":\"\xf4\x90\x80\x80\"}" },
+        { "stray continuation byte", "{\"a\":\"abcdefgh\x80\"}" }
+    };
+    for(const QPair<QString, QByteArray>& document : malformed) failed += checkParity(document.first, document.second);
+
+    // raw control characters have to be escaped
+    failed += checkRejected("raw newline", "{\"a\":\"line\nline\"}", QJsonParseError::IllegalValue);
+    failed += checkRejected("raw tab", "{\"a\":\"abcdefghijklmnop\tq\"}", QJsonParseError::IllegalValue);
+    failed += checkRejected("raw control character in key", "{\"\x01\":1}", QJsonParseError::IllegalValue);
+    failed += checkRejected("invalid utf-8 in escaped string", "{\"a\":\"\\n\xff\"}", QJsonParseError::IllegalUTF8String);
+
+    qInfo("%s (%i failed)", failed ? "JsonDecoder parity check failed" : "JsonDecoder parity check passed", failed);
+    return failed;
+}
@@ -0,0 +1,437 @@
+#include "jsondecoder.h"
+
+#include <cstring>
+#include <QtAlgorithms>
+
+// the SIMD classifiers are compiled for their target only and selected at runtime, so the binary still runs on cpus without AVX2 or SSE4.2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define JSONDECODER_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // bit masks of a 64 byte block (bit i = byte i)
+    struct BlockMasks
+    {
+        quint64 quote;
+        quint64 backslash;
+        quint64 structural; // { } [ ] : ,
+    };
+    typedef void (*BlockClassifier)(const char* block, BlockMasks& masks);
+
+    void classifyScalar(const char* block, BlockMasks& masks)
+    {
+        masks = { 0, 0, 0 };
+        for(int i = 0; i < 64; i++) {
+            quint64 bit = static_cast<quint64>(1) << i;
+            switch(block[i]) {
+                case '"': masks.quote |= bit; break;
+                case '\\': masks.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': masks.structural |= bit; break;
+            }
+        }
+    }
+
+#ifdef JSONDECODER_X86
+    __attribute__((target("avx2"))) inline quint64 avx2Match(__m256i chunk, char c)
+    {
+        return static_cast<quint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c))));
+    }
+
+    __attribute__((target("avx2"))) void classifyAvx2(const char* block, BlockMasks& masks)
+    {
+        masks = { 0, 0, 0 };
+        for(int half = 0; half < 2; half++) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + half * 32));
+
+            // '[' and ']' differ from '{' and '}' only by bit 0x20, so 4 compares find all 6 structural characters
+            __m256i lowered = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+            masks.quote |= avx2Match(chunk, '"') << (half * 32);
+            masks.backslash |= avx2Match(chunk, '\\') << (half * 32);
+            masks.structural |= (avx2Match(lowered, '{') | avx2Match(lowered, '}') | avx2Match(chunk, ':') | avx2Match(chunk, ',')) << (half * 32);
+        }
+    }
+
+    __attribute__((target("sse4.2"))) void classifySse42(const char* block, BlockMasks& masks)
+    {
+        masks = { 0, 0, 0 };
+        const __m128i structurals = _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for(int quarter = 0; quarter < 4; quarter++) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + quarter * 16));
+            quint64 quote = static_cast<quint16>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'))));
+            quint64 backslash = static_cast<quint16>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))));
+            quint64 structural = static_cast<quint16>(_mm_cvtsi128_si32(_mm_cmpestrm(structurals, 6, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK)));
+            masks.quote |= quote << (quarter * 16);
+            masks.backslash |= backslash << (quarter * 16);
+            masks.structural |= structural << (quarter * 16);
+        }
+    }
+#endif
+
+    BlockClassifier selectClassifier()
+    {
+#ifdef JSONDECODER_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return classifyAvx2;
+        if(__builtin_cpu_supports("sse4.2")) return classifySse42;
+#endif
+        return classifyScalar;
+    }
+    const BlockClassifier classifyBlock = selectClassifier();
+
+    // bit i is the xor of the bits 0..i (turns the quote mask into the mask of string contents)
+    inline quint64 prefixXor(quint64 bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    inline bool isWhitespace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    inline bool readHex4(const char* text, uint& code)
+    {
+        code = 0;
+        for(int i = 0; i < 4; i++) {
+            char c = text[i];
+            int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            if(digit < 0) return false;
+            code = code << 4 | static_cast<uint>(digit);
+        }
+        return true;
+    }
+
+    // offset of the first raw control character (IllegalValue) or invalid utf-8 sequence (IllegalUTF8String) of a string, -1 if it's valid
+    // utf-8 is invalid if it's truncated, overlong, encodes a surrogate or is beyond U+10FFFF
+    inline int findInvalidByte(const char* text, int length, QJsonParseError::ParseError& error)
+    {
+        const uchar* c = reinterpret_cast<const uchar*>(text);
+        const uchar* end = c + length;
+        while(c < end) {
+            // plain ascii is checked 8 bytes at a time (a high bit is set for every byte below 0x20 or above 0x7F)
+            quint64 word;
+            if(end - c >= 8) {
+                std::memcpy(&word, c, 8);
+                if(!((word | (word - 0x2020202020202020ULL)) & 0x8080808080808080ULL)) {
+                    c += 8;
+                    continue;
+                }
+            }
+
+            uint code = *c;
+            int offset = static_cast<int>(c - reinterpret_cast<const uchar*>(text));
+            if(code < 0x20) {
+                error = QJsonParseError::IllegalValue;
+                return offset;
+            }
+            if(code < 0x80) {
+                c++;
+                continue;
+            }
+
+            int follow = (code & 0xE0) == 0xC0 ? 1 : (code & 0xF0) == 0xE0 ? 2 : (code & 0xF8) == 0xF0 ? 3 : 0;
+            uint minimum = follow == 1 ? 0x80 : follow == 2 ? 0x800 : 0x10000;
+            code &= 0x3F >> follow;
+            bool valid = follow && end - c > follow;
+            for(int i = 1; valid && i <= follow; i++) {
+                valid = (c[i] & 0xC0) == 0x80;
+                code = code << 6 | (c[i] & 0x3F);
+            }
+            if(!valid || code < minimum || code > 0x10FFFF || (code >= 0xD800 && code < 0xE000)) {
+                error = QJsonParseError::IllegalUTF8String;
+                return offset;
+            }
+            c += follow + 1;
+        }
+        return -1;
+    }
+}
+
+JsonDecoder::JsonDecoder(const QByteArray& data) : data(data.constData()), length(data.length()) { }
+
+QJsonObject JsonDecoder::decodeObject(const QByteArray& data, QJsonParseError* error)
+{
+    // decode (like QJsonDocument a document has to be an object or an array, an array results in an empty object)
+    JsonDecoder decoder(data);
+    QJsonValue value;
+    if(decoder.buildIndex() && decoder.parseValue(value, 0)) {
+        if(!value.isObject() && !value.isArray()) decoder.fail(QJsonParseError::IllegalValue, 0);
+        else {
+            while(decoder.end < decoder.length && isWhitespace(decoder.data[decoder.end])) decoder.end++;
+            if(decoder.end < decoder.length) decoder.fail(QJsonParseError::GarbageAtEnd, decoder.end);
+        }
+    }
+
+    if(error) {
+        error->error = decoder.error;
+        error->offset = decoder.errorOffset;
+    }
+    return decoder.error == QJsonParseError::NoError ? value.toObject() : QJsonObject();
+}
+
+/*
+ *  Stage 1: structural index
+ */
+bool JsonDecoder::buildIndex()
+{
+    const quint64 evenBits = 0x5555555555555555ULL;
+    quint64 prevEscaped = 0; // the first character of the block is escaped by the previous block
+    quint64 prevInString = 0; // all bits set, if the previous block ended inside a string
+    char tail[64];
+    this->index.reserve(this->length / 8);
+
+    for(int blockStart = 0; blockStart < this->length; blockStart += 64) {
+        // the last block is padded with whitespace
+        const char* block = this->data + blockStart;
+        if(this->length - blockStart < 64) {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, static_cast<size_t>(this->length - blockStart));
+            block = tail;
+        }
+        BlockMasks masks;
+        classifyBlock(block, masks);
+
+        // escaped characters: every backslash sequence of odd length escapes the character behind it
+        quint64 backslash = masks.backslash & ~prevEscaped;
+        quint64 followsEscape = backslash << 1 | prevEscaped;
+        quint64 oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+        quint64 sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+        prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts;
+        quint64 escaped = (evenBits ^ (sequencesStartingOnEvenBits << 1)) & followsEscape;
+
+        // string contents are between the unescaped quotes, structural characters in there are no structurals
+        quint64 quote = masks.quote & ~escaped;
+        quint64 inString = prefixXor(quote) ^ prevInString;
+        prevInString = static_cast<quint64>(static_cast<qint64>(inString) >> 63);
+        quint64 structural = (masks.structural & ~inString) | quote;
+
+        while(structural) {
+            this->index.append(static_cast<quint32>(blockStart) + qCountTrailingZeroBits(structural));
+            structural &= structural - 1;
+        }
+    }
+
+    if(prevInString) return this->fail(QJsonParseError::UnterminatedString, this->length);
+    return true;
+}
+
+/*
+ *  Stage 2: values
+ */
+bool JsonDecoder::parseValue(QJsonValue& value, int depth)
+{
+    // scalars (numbers, true, false, null) have no index entry, they end in front of the next structural character
+    int next = this->position < this->index.length() ? static_cast<int>(this->index.at(this->position)) : this->length;
+    int begin = this->end;
+    while(begin < next && isWhitespace(this->data[begin])) begin++;
+    if(begin < next) {
+        this->end = next;
+        return this->parseScalar(value, begin, next);
+    }
+    if(next == this->length) return this->fail(QJsonParseError::IllegalValue, begin);
+
+    // strings, objects and arrays
+    if(depth >= 1024) return this->fail(QJsonParseError::DeepNesting, next);
+    this->consume();
+    switch(this->data[next]) {
+        case '"': {
+            QString string;
+            if(!this->parseString(string, next)) return false;
+            value = string;
+            return true;
+        }
+        case '{': {
+            QJsonObject object;
+            if(!this->parseObject(object, depth + 1)) return false;
+            value = object;
+            return true;
+        }
+        case '[': {
+            QJsonArray array;
+            if(!this->parseArray(array, depth + 1)) return false;
+            value = array;
+            return true;
+        }
+    }
+    return this->fail(QJsonParseError::IllegalValue, next);
+}
+
+bool JsonDecoder::parseObject(QJsonObject& object, int depth)
+{
+    if(this->nextStructural() == '}') return this->consume() >= 0;
+    while(true) {
+        // key
+        if(this->nextStructural() != '"') return this->fail(QJsonParseError::IllegalValue, this->end);
+        QString key;
+        if(!this->parseString(key, this->consume())) return false;
+        if(this->nextStructural() != ':') return this->fail(QJsonParseError::MissingNameSeparator, this->end);
+        this->consume();
+
+        // value
+        QJsonValue value;
+        if(!this->parseValue(value, depth)) return false;
+        object.insert(key, value);
+
+        char c = this->nextStructural();
+        if(c == '}') return this->consume() >= 0;
+        if(c != ',') return this->fail(c ? QJsonParseError::MissingValueSeparator : QJsonParseError::UnterminatedObject, this->end);
+        this->consume();
+    }
+}
+
+bool JsonDecoder::parseArray(QJsonArray& array, int depth)
+{
+    if(this->nextStructural() == ']') return this->consume() >= 0;
+    while(true) {
+        QJsonValue value;
+        if(!this->parseValue(value, depth)) return false;
+        array.append(value);
+
+        char c = this->nextStructural();
+        if(c == ']') return this->consume() >= 0;
+        if(c != ',') return this->fail(c ? QJsonParseError::MissingValueSeparator : QJsonParseError::UnterminatedArray, this->end);
+        this->consume();
+    }
+}
+
+bool JsonDecoder::parseString(QString& string, int open)
+{
+    // the closing quote is the next index entry (escaped quotes aren't indexed)
+    if(this->position >= this->index.length()) return this->fail(QJsonParseError::UnterminatedString, open);
+    int close = this->consume();
+    const char* begin = this->data + open + 1;
+    int length = close - open - 1;
+
+    // control characters have to be escaped and the string has to be valid utf-8 (escape sequences are plain ascii, so the raw bytes are checked for both paths)
+    QJsonParseError::ParseError invalid;
+    int invalidOffset = findInvalidByte(begin, length, invalid);
+    if(invalidOffset >= 0) return this->fail(invalid, open + 1 + invalidOffset);
+
+    // most strings have no escape sequences, so they are converted directly
+    if(!std::memchr(begin, '\\', static_cast<size_t>(length))) {
+        string = QString::fromUtf8(begin, length);
+        return true;
+    }
+
+    // the raw runs between the escape sequences are converted as a whole, escaped characters are appended as utf-16 code units,
+    // so surrogate pairs are joined and lone surrogates are kept (like QJsonDocument does)
+    QString decoded;
+    decoded.reserve(length);
+    const char* run = begin;
+    for(const char* c = begin; c < begin + length; c++) {
+        if(*c != '\\') continue;
+        if(c > run) decoded.append(QString::fromUtf8(run, static_cast<int>(c - run)));
+
+        // an unescaped quote always follows, so the escape sequence can't reach beyond the data
+        c++;
+        switch(*c) {
+            case '"': case '\\': case '/': decoded.append(QLatin1Char(*c)); break;
+            case 'b': decoded.append(QLatin1Char('\b')); break;
+            case 'f': decoded.append(QLatin1Char('\f')); break;
+            case 'n': decoded.append(QLatin1Char('\n')); break;
+            case 'r': decoded.append(QLatin1Char('\r')); break;
+            case 't': decoded.append(QLatin1Char('\t')); break;
+            case 'u': {
+                uint code;
+                if(begin + length - c <= 4 || !readHex4(c + 1, code)) return this->fail(QJsonParseError::IllegalEscapeSequence, static_cast<int>(c - this->data));
+                c += 4;
+                decoded.append(QChar(static_cast<ushort>(code)));
+                break;
+            }
+            default: return this->fail(QJsonParseError::IllegalEscapeSequence, static_cast<int>(c - this->data));
+        }
+        run = c + 1;
+    }
+    if(run < begin + length) decoded.append(QString::fromUtf8(run, static_cast<int>(begin + length - run)));
+    string = decoded;
+    return true;
+}
+
+bool JsonDecoder::parseScalar(QJsonValue& value, int begin, int end)
+{
+    while(end > begin && isWhitespace(this->data[end - 1])) end--;
+    const char* text = this->data + begin;
+    int length = end - begin;
+
+    // literals
+    if((length == 4 && !std::memcmp(text, "true", 4)) || (length == 5 && !std::memcmp(text, "false", 5))) {
+        value = QJsonValue(*text == 't');
+        return true;
+    }
+    if(length == 4 && !std::memcmp(text, "null", 4)) {
+        value = QJsonValue(QJsonValue::Null);
+        return true;
+    }
+    if(*text != '-' && (*text < '0' || *text > '9')) return this->fail(QJsonParseError::IllegalValue, begin);
+
+    // number: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    int i = *text == '-' ? 1 : 0;
+    int digits = 0;
+    qint64 integer = 0;
+    // (only 18 digits are accumulated, so the integer can't overflow, longer numbers are converted to double below)
+    while(i < length && text[i] >= '0' && text[i] <= '9' && digits < 18) {
+        integer = integer * 10 + (text[i++] - '0');
+        digits++;
+    }
+    bool valid = digits && !(digits > 1 && text[i - digits] == '0');
+    bool isInteger = valid && i == length;
+    if(!isInteger && valid) {
+        while(i < length && text[i] >= '0' && text[i] <= '9') i++;
+        if(i < length && text[i] == '.') {
+            int fraction = ++i;
+            while(i < length && text[i] >= '0' && text[i] <= '9') i++;
+            valid = i > fraction;
+        }
+        if(valid && i < length && (text[i] == 'e' || text[i] == 'E')) {
+            if(++i < length && (text[i] == '+' || text[i] == '-')) i++;
+            int exponent = i;
+            while(i < length && text[i] >= '0' && text[i] <= '9') i++;
+            valid = i > exponent;
+        }
+        valid = valid && i == length;
+    }
+    if(!valid) return this->fail(QJsonParseError::IllegalNumber, begin);
+
+    // integers up to 18 digits are exact, everything else is converted locale independently
+    if(isInteger) value = QJsonValue(*text == '-' ? -integer : integer);
+    else value = QJsonValue(QByteArray::fromRawData(text, length).toDouble());
+    return true;
+}
+
+/*
+ *  Helpers
+ */
+char JsonDecoder::nextStructural()
+{
+    // the next structural character, if there is only whitespace in front of it
+    if(this->position >= this->index.length()) return 0;
+    int next = static_cast<int>(this->index.at(this->position));
+    for(int i = this->end; i < next; i++) {
+        if(!isWhitespace(this->data[i])) return 0;
+    }
+    return this->data[next];
+}
+
+int JsonDecoder::consume()
+{
+    int offset = static_cast<int>(this->index.at(this->position++));
+    this->end = offset + 1;
+    return offset;
+}
+
+bool JsonDecoder::fail(QJsonParseError::ParseError error, int offset)
+{
+    if(this->error == QJsonParseError::NoError) {
+        this->error = error;
+        this->errorOffset = offset;
+    }
+    return false;
+}
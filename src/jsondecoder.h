@@ -0,0 +1,49 @@
+#ifndef JSONDECODER_H
+#define JSONDECODER_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QString>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QJsonParseError>
+
+// JsonDecoder - json tokenizer backend in the style of simdjson (compile with CONFIG += telegrambot_simdjson)
+// stage 1 builds an index of all structural characters and quotes outside of strings 64 bytes at a time (with AVX2 or SSE4.2 if the cpu supports it, otherwise scalar),
+// stage 2 builds the json values along this index, so the data is never scanned character by character again
+// Note: the result is still a QJsonObject DOM like the one of QJsonDocument, which is converted by the data structs afterwards (they aren't filled directly),
+//       strings have to be valid utf-8 without raw control characters, integers with more than 18 digits are decoded as double
+class JsonDecoder
+{
+    public:
+        static QJsonObject decodeObject(const QByteArray& data, QJsonParseError* error = 0);
+
+    private:
+        explicit JsonDecoder(const QByteArray& data);
+
+        // stage 1
+        bool buildIndex();
+
+        // stage 2
+        bool parseValue(QJsonValue& value, int depth);
+        bool parseObject(QJsonObject& object, int depth);
+        bool parseArray(QJsonArray& array, int depth);
+        bool parseString(QString& string, int open);
+        bool parseScalar(QJsonValue& value, int begin, int end);
+
+        // helpers
+        char nextStructural();
+        int consume();
+        bool fail(QJsonParseError::ParseError error, int offset);
+
+        const char* data;
+        int length;
+        QVector<quint32> index; // byte offsets of the structural characters
+        int position = 0; // next entry of the index
+        int end = 0; // byte offset behind the last parsed token
+        QJsonParseError::ParseError error = QJsonParseError::NoError;
+        int errorOffset = 0;
+};
+
+#endif // JSONDECODER_H
@@ -1,31 +1,81 @@
 #include "jsonhelper.h"
 
+#ifdef TELEGRAMBOT_SIMDJSON
+#include "jsondecoder.h"
+#endif
+
+JsonPath::JsonPath(QString path) : path(path), elements(path.split('.', QString::SkipEmptyParts))
+{
+    // array indexes are parsed only once
+    for(const QString& element : this->elements) {
+        bool isInt;
+        int index = element.toInt(&isInt);
+        this->indexes.append(isInt ? index : -1);
+    }
+}
+
 QVariant JsonHelper::jsonPathGetImpl(QJsonValue data, QString path, bool showWarnings)
 {
-    // json parse
-    QStringList splittedPath = path.split('.', QString::SkipEmptyParts);
-    QStringList processed;
-    while(!splittedPath.isEmpty()) {
-        QString pathElement = splittedPath.takeFirst();
-        processed += pathElement;
+    // if we reach data end before path end, the value is returned as plain variant, otherwise correct converted to the right type (so that the user can continue process)
+    bool dataEnd = false;
+    data = data.isObject() && !path.contains('.') ? JsonHelper::jsonPathValue(data, path, showWarnings) : JsonHelper::jsonPathValueImpl(data, JsonPath(path), showWarnings, &dataEnd);
+    return dataEnd ? data.toVariant() : JsonHelper::jsonValueToVariant(data);
+}
+
+QJsonObject JsonHelper::jsonParseObject(const QByteArray& data, QJsonParseError* error)
+{
+#ifdef TELEGRAMBOT_SIMDJSON
+    return JsonDecoder::decodeObject(data, error);
+#else
+    return QJsonDocument::fromJson(data, error).object();
+#endif
+}
+
+QJsonValue JsonHelper::jsonPathValue(const QJsonValue& data, const QString& path, bool showWarnings)
+{
+    // fast path: single key lookup in an object (this is nearly every lookup of the telegram data structs), without splitting the path
+    if(data.isObject() && !path.isEmpty() && !path.contains('.')) {
+        QJsonObject jObject = data.toObject();
+        auto itr = jObject.constFind(path);
+        if(itr != jObject.constEnd()) return itr.value();
+        if(showWarnings) qWarning("JsonHelper::jsonPath: pos: %s -> QJsonObject path element not found", qPrintable(path));
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    // an empty path, or a path into a plain value (e.g. the elements of a value array) always returns the value itself
+    if(path.isEmpty() || (!data.isObject() && !data.isArray() && !path.contains('.'))) return data;
+    return JsonHelper::jsonPathValueImpl(data, JsonPath(path), showWarnings);
+}
+
+QJsonValue JsonHelper::jsonPathValue(const QJsonValue& data, const JsonPath& path, bool showWarnings)
+{
+    return JsonHelper::jsonPathValueImpl(data, path, showWarnings);
+}
+
+QJsonValue JsonHelper::jsonPathValueImpl(QJsonValue data, const JsonPath& path, bool showWarnings, bool* dataEnd)
+{
+    // json parse (the processed path is only built for warnings)
+    auto processed = [&path](int i) { return QStringList(path.elements.mid(0, i + 1)).join("."); };
+    for(int i = 0; i < path.elements.length(); i++) {
+        const QString& pathElement = path.elements.at(i);
 
         // if we have an invalid value, return it
         if(data.isUndefined()) return data;
 
         // handle QJsonArray
         if(data.type() == QJsonValue::Array) {
-            bool isInt;
-            int intPath = pathElement.toInt(&isInt);
+            int intPath = path.indexes.at(i);
             QJsonArray jArray = data.toArray();
+            bool isInt = intPath >= 0;
+            if(!isInt) pathElement.toInt(&isInt);
             if(!isInt) {
-                if(showWarnings) qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray path element is non numeric",  qPrintable(processed.join(".")));
-                intPath = -1;
+                if(showWarnings) qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray path element is non numeric",  qPrintable(processed(i)));
             }
             else if(showWarnings && jArray.count() <= intPath) {
                 if(jArray.count() >= 1) {
-                    qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray with length %i, is smaller than requested",  qPrintable(processed.join(".")), jArray.count());
+                    qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray with length %i, is smaller than requested",  qPrintable(processed(i)), jArray.count());
                 } else {
-                    qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray is empty so cannot access requested index",  qPrintable(processed.join(".")));
+                    qWarning("JsonHelper::jsonPath: pos: %s -> QJsonArray is empty so cannot access requested index",  qPrintable(processed(i)));
                 }
             }
             data = jArray.at(intPath);
@@ -34,23 +84,109 @@ QVariant JsonHelper::jsonPathGetImpl(QJsonValue data, QString path, bool showWar
         // handle QJsonObject
         else if(data.type() == QJsonValue::Object) {
             QJsonObject jObject = data.toObject();
-            if(showWarnings && !jObject.contains(pathElement)) {
-                qWarning("JsonHelper::jsonPath: pos: %s -> QJsonObject path element not found",  qPrintable(processed.join(".")));
+            auto itr = jObject.constFind(pathElement);
+            if(itr == jObject.constEnd()) {
+                if(showWarnings) qWarning("JsonHelper::jsonPath: pos: %s -> QJsonObject path element not found",  qPrintable(processed(i)));
+                data = QJsonValue(QJsonValue::Undefined);
             }
-            data = jObject.value(pathElement);
+            else data = itr.value();
         }
 
         // handle all other data types
         else {
-            if(showWarnings && !splittedPath.isEmpty()) {
-                qWarning("JsonHelper::jsonPath: pos: %s -> Reached data end, but still path data available (%s)", qPrintable(processed.join(".")), qPrintable(splittedPath.join(".")));
+            if(showWarnings && i + 1 < path.elements.length()) {
+                qWarning("JsonHelper::jsonPath: pos: %s -> Reached data end, but still path data available (%s)", qPrintable(processed(i)), qPrintable(QStringList(path.elements.mid(i + 1)).join(".")));
+            }
+            if(dataEnd) *dataEnd = true;
+            return data;
+        }
+    }
+
+    // if we reach this point we have not reached the tail of the json object, so we just return the current position
+    return data;
+}
+
+JsonStreamReader::JsonStreamReader(QString arrayKey) : arrayKey(arrayKey.toUtf8()) { }
+
+void JsonStreamReader::reset()
+{
+    *this = JsonStreamReader(QString::fromUtf8(this->arrayKey));
+}
+
+void JsonStreamReader::append(const QByteArray& data)
+{
+    this->buffer.append(data);
+}
+
+bool JsonStreamReader::readNext(QJsonObject& element)
+{
+    // scan the structure (all structural characters are ascii, so the utf-8 data can be scanned bytewise)
+    while(this->position < this->buffer.length()) {
+        char c = this->buffer.at(this->position++);
+
+        // strings (the keys of the envelope are remembered to find the array)
+        if(this->inString) {
+            if(this->escaped) this->escaped = false;
+            else if(c == '\\') this->escaped = true;
+            else if(c == '"') {
+                this->inString = false;
+                if(this->depth == 1) this->lastKey = this->buffer.mid(this->keyStart, this->position - 1 - this->keyStart);
+            }
+            continue;
+        }
+
+        if(c == '"') {
+            this->inString = true;
+            this->keyStart = this->position;
+        }
+        else if(c == '{' || c == '[') {
+            this->depth++;
+            if(this->arrayDepth > 0) {
+                if(this->depth == this->arrayDepth + 1 && this->elementStart < 0) this->elementStart = this->position - 1;
+            }
+            else if(!this->arrayDepth && c == '[' && this->depth == 2 && this->lastKey == this->arrayKey) {
+                this->arrayDepth = 2;
+                this->consume(this->position, true);
+            }
+        }
+        else if(c == '}' || c == ']') {
+            this->depth--;
+
+            // element complete, decode it and drop it's data
+            if(this->arrayDepth > 0 && this->depth == this->arrayDepth && this->elementStart >= 0) {
+                QJsonParseError jError;
+                element = JsonHelper::jsonParseObject(QByteArray::fromRawData(this->buffer.constData() + this->elementStart, this->position - this->elementStart), &jError);
+                this->elementStart = -1;
+                this->consume(this->position, false);
+                if(jError.error == QJsonParseError::NoError) return true;
+                qWarning("JsonStreamReader::readNext - Parse Error: %s, element skipped", qPrintable(jError.errorString()));
+            }
+
+            // array end, the rest belongs to the envelope again
+            else if(this->arrayDepth > 0 && this->depth < this->arrayDepth) {
+                this->arrayDepth = -1;
+                this->consume(this->position - 1, false);
             }
-            return data.toVariant();
         }
     }
 
-    // if we reach this point we have not reached the tail of the json object, so we just return the current position (correct converted to the right type!), so that the user can continue process
-    return data.isObject() ? QVariant::fromValue(data.toObject()) :
-           data.isArray()  ? QVariant::fromValue(data.toArray()) :
-                             QVariant::fromValue(data);
+    // keep only the current element (or key) in the buffer
+    if(this->arrayDepth > 0) this->consume(this->elementStart >= 0 ? this->elementStart : this->position, false);
+    else this->consume(this->inString ? this->keyStart - 1 : this->position, true);
+    return false;
+}
+
+QJsonObject JsonStreamReader::envelope(QJsonParseError* error) const
+{
+    // the array elements are read already, so the envelope is parsed with an empty array (e.g. {"ok":true,"result":[]})
+    return JsonHelper::jsonParseObject(this->envelopeData + this->buffer, error);
+}
+
+void JsonStreamReader::consume(int length, bool envelope)
+{
+    if(envelope) this->envelopeData.append(this->buffer.constData(), length);
+    this->buffer.remove(0, length);
+    this->position -= length;
+    this->keyStart -= length;
+    if(this->elementStart >= 0) this->elementStart -= length;
 }
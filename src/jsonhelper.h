@@ -2,9 +2,52 @@
 #define JSONHELPER_H
 
 #include <QVariant>
+#include <QVector>
+#include <QStringList>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+// JsonPath - precompiled json path (e.g. "message.chat.id"), build it once (e.g. as static object) and reuse it for every lookup
+class JsonPath
+{
+    public:
+        explicit JsonPath(QString path);
+
+        QString path;
+        QStringList elements;
+        QVector<int> indexes; // array index of every element (-1 if the element is non numeric)
+};
+
+// JsonStreamReader - incremental reader for the elements of an array inside a json object (e.g. the "result" array of a getUpdates answer)
+// the data can be appended in chunks while it arrives, every complete element is decoded on it's own, so the document of the whole object is never built
+class JsonStreamReader
+{
+    public:
+        explicit JsonStreamReader(QString arrayKey = "result");
+
+        void reset();
+        void append(const QByteArray& data);
+        bool readNext(QJsonObject& element); // false if no further complete element is available yet (only object elements are returned)
+        QJsonObject envelope(QJsonParseError* error = 0) const; // the object with an empty array, complete as soon as all data is appended and read
+
+    private:
+        void consume(int length, bool envelope);
+
+        QByteArray arrayKey;
+        QByteArray buffer; // unscanned data and the current element
+        QByteArray envelopeData;
+        QByteArray lastKey;
+        int position = 0;
+        int keyStart = 0;
+        int elementStart = -1;
+        int depth = 0;
+        int arrayDepth = 0; // depth of the array elements (0 = before the array, -1 = behind it)
+        bool inString = false;
+        bool escaped = false;
+};
 
 class JsonHelper
 {
@@ -13,18 +56,47 @@ class JsonHelper
         template<typename T>
         static bool jsonPathGet(QJsonValue data, QString path, T& target, bool showWarnings = true)
         {
-            // get value and exit if value is invalid, or is not convertable to T
-            QVariant jPathValue = JsonHelper::jsonPathGetImpl(data, path, showWarnings);
-            target = jPathValue.value<T>();
-
-            // return true if convert was successfull otherwise false
-            return jPathValue != QJsonValue(QJsonValue::Undefined) && !jPathValue.canConvert<T>();
+            return JsonHelper::jsonValueGet(JsonHelper::jsonPathValue(data, path, showWarnings), target);
+        }
+        template<typename T>
+        static bool jsonPathGet(QJsonValue data, const JsonPath& path, T& target, bool showWarnings = true)
+        {
+            return JsonHelper::jsonValueGet(JsonHelper::jsonPathValue(data, path, showWarnings), target);
         }
         static inline QVariant jsonPathGet(QJsonValue data, QString path) { return JsonHelper::jsonPathGetImpl(data, path, true); }
         static inline QVariant jsonPathGetSilent(QJsonValue data, QString path) { return JsonHelper::jsonPathGetImpl(data, path, false); }
 
+        // json decoder backend for api answers (QJsonDocument, or with CONFIG += telegrambot_simdjson the SIMD JsonDecoder), returns an empty object on errors
+        static QJsonObject jsonParseObject(const QByteArray& data, QJsonParseError* error = 0);
+
+        // raw json value of a path (undefined if the path don't exist)
+        static QJsonValue jsonPathValue(const QJsonValue& data, const QString& path, bool showWarnings = true);
+        static QJsonValue jsonPathValue(const QJsonValue& data, const JsonPath& path, bool showWarnings = true);
+
+        // value converters, they convert exactly like QVariant and return true if the value exists, but is not convertable to T
+        // Note: the types used by the telegram data structs are converted directly, without boxing them into a QVariant
+        template<typename T>
+        static bool jsonValueGet(const QJsonValue& value, T& target)
+        {
+            QVariant jPathValue = JsonHelper::jsonValueToVariant(value);
+            target = jPathValue.value<T>();
+            return jPathValue != QJsonValue(QJsonValue::Undefined) && !jPathValue.canConvert<T>();
+        }
+        static inline bool jsonValueGet(const QJsonValue& value, QString& target) { target = value.toString(); return false; }
+        static inline bool jsonValueGet(const QJsonValue& value, bool& target) { target = value.toBool(); return false; }
+        static inline bool jsonValueGet(const QJsonValue& value, double& target) { target = value.toDouble(); return false; }
+        static inline bool jsonValueGet(const QJsonValue& value, qint32& target) { target = value.isDouble() ? static_cast<qint32>(qRound64(value.toDouble())) : 0; return false; }
+        static inline bool jsonValueGet(const QJsonValue& value, qint64& target) { target = value.isDouble() ? qRound64(value.toDouble()) : 0; return false; }
+
     private:
         static QVariant jsonPathGetImpl(QJsonValue data, QString path, bool showWarnings);
+        static QJsonValue jsonPathValueImpl(QJsonValue data, const JsonPath& path, bool showWarnings, bool* dataEnd = 0);
+        static inline QVariant jsonValueToVariant(const QJsonValue& value)
+        {
+            return value.isObject() ? QVariant::fromValue(value.toObject()) :
+                   value.isArray()  ? QVariant::fromValue(value.toArray()) :
+                                      QVariant::fromValue(value);
+        }
 };
 
 template<typename T, class Enable = void>
@@ -37,7 +109,7 @@ class JsonHelperT
         }
         static bool jsonPathGetArray(QJsonValue data, QString path, QList<T>& target, bool showWarnings = true)
         {
-            QJsonValue value = showWarnings ? JsonHelper::jsonPathGet(data, path).toJsonValue() : JsonHelper::jsonPathGetSilent(data, path).toJsonValue();
+            QJsonValue value = JsonHelper::jsonPathValue(data, path, showWarnings);
             if(value.isArray()) {
                 QJsonArray jArray = value.toArray();
                 for(auto itr = jArray.begin(); itr != jArray.end(); itr++) {
@@ -55,7 +127,7 @@ class JsonHelperT
         }
         static bool jsonPathGetArrayArray(QJsonValue data, QString path, QList<QList<T>>& target, bool showWarnings = true)
         {
-            QJsonValue value = showWarnings ? JsonHelper::jsonPathGet(data, path).toJsonValue() : JsonHelper::jsonPathGetSilent(data, path).toJsonValue();
+            QJsonValue value = JsonHelper::jsonPathValue(data, path, showWarnings);
             if(value.isArray()) {
                 QJsonArray jArray = value.toArray();
                 for(auto itr = jArray.begin(); itr != jArray.end(); itr++) {
@@ -1,7 +1,12 @@
 #include "telegrambot.h"
 
+Q_LOGGING_CATEGORY(telegramBotTrace, "telegrambot.trace", QtWarningMsg)
+
 QMap<qint16, HttpServer*> TelegramBot::webHookWebServers = QMap<qint16, HttpServer*>();
 
+// request priority of the calling thread (set by setRequestPriority or a TelegramBotPriorityScope)
+static thread_local TelegramBot::TelegramRequestPriority threadRequestPriority = TelegramBot::InferPriority;
+
 
 TelegramKeyboardRequest TelegramBot::constructInlineMenu(QList<QString> menu, QString dataPattern, int page, int columns, int limit, QString lastPage)
 {
@@ -40,11 +45,48 @@ TelegramKeyboardRequest TelegramBot::constructInlineMenu(QList<QString> menu, QS
     return keyboard;
 }
 
-TelegramBot::TelegramBot(QString apikey, QObject *parent) : QObject(parent), apiKey(apikey) { }
+TelegramBot::TelegramBot(QString apikey, QObject *parent) : QObject(parent), apiKey(apikey)
+{
+    // request dispatcher
+    this->requestTimer.setSingleShot(true);
+    QObject::connect(&this->requestTimer, &QTimer::timeout, this, &TelegramBot::processRequestQueue);
+
+#ifdef TELEGRAMBOT_TRACE
+    // request tracing
+    this->traceTimer.setSingleShot(true);
+    this->traceTimer.setInterval(1000);
+    QObject::connect(&this->traceTimer, &QTimer::timeout, this, &TelegramBot::flushTrace);
+#endif
+
+    // message puller watchdog
+    this->pullWatchdog.setSingleShot(true);
+    QObject::connect(&this->pullWatchdog, &QTimer::timeout, this, &TelegramBot::handlePullStall);
+
+    // offset checkpoints without pulling (webhook or distributed updates)
+    this->offsetCheckpointTimer.setSingleShot(true);
+    this->offsetCheckpointTimer.setInterval(1000);
+    QObject::connect(&this->offsetCheckpointTimer, &QTimer::timeout, this, &TelegramBot::checkpointOffset);
+
+    // traffic replay
+    this->trafficReplayTimer.setSingleShot(true);
+    QObject::connect(&this->trafficReplayTimer, &QTimer::timeout, this, &TelegramBot::replayNextFrame);
+
+    // connection keep alive
+    QObject::connect(&this->keepAliveTimer, &QTimer::timeout, this, &TelegramBot::keepAlive);
+
+    // open the api connection now, so that the first api call don't pay for DNS, TCP and TLS setup
+    this->preconnect();
+}
 
 TelegramBot::~TelegramBot()
 {
     qDeleteAll(this->messageRoutes);
+    qDeleteAll(this->broadcasts);
+    this->checkpointOffset();
+    delete this->offsetStore;
+    this->stopUpdateDistribution();
+    this->stopTrafficRecording();
+    this->stopDispatchThreads();
 }
 
 /*
@@ -52,10 +94,26 @@ TelegramBot::~TelegramBot()
  */
 TelegramBotUser TelegramBot::getMe()
 {
-    return TelegramBotUser(this->callApiJson("getMe").value("result").toObject());
+    TelegramBotUser user;
+    TelegramBotSyncResponse<TelegramBotUser> sync(&user);
+    this->getMe(sync.delegate());
+    sync.wait();
+    return user;
+}
+
+void TelegramBot::getMe(QDelegate<void(TelegramBotUser)> delegate)
+{
+    this->callApiTemplate("getMe", TelegramBotParams(), delegate);
 }
 
 void TelegramBot::sendChatAction(QVariant chatId, TelegramBotChatAction action, bool *response)
+{
+    TelegramBotSyncResponse<bool> sync(response);
+    this->sendChatAction(chatId, action, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendChatAction(QVariant chatId, TelegramBotChatAction action, QDelegate<void(bool)> delegate)
 {
     return this->sendChatAction(chatId, action == TelegramBotChatAction::Typing            ? "typing" :
                                         action == TelegramBotChatAction::UploadPhoto       ? "upload_photo" :
@@ -66,36 +124,55 @@ void TelegramBot::sendChatAction(QVariant chatId, TelegramBotChatAction action,
                                         action == TelegramBotChatAction::UploadDocument    ? "upload_document" :
                                         action == TelegramBotChatAction::FindLocation      ? "find_location" :
                                         action == TelegramBotChatAction::RecordVideoNote   ? "record_video_note" :
-                                        action == TelegramBotChatAction::UploadVideoNote   ? "upload_video_note" : "", response);
+                                        action == TelegramBotChatAction::UploadVideoNote   ? "upload_video_note" : "", delegate);
 }
 
 void TelegramBot::sendChatAction(QVariant chatId, QString action, bool *response)
+{
+    TelegramBotSyncResponse<bool> sync(response);
+    this->sendChatAction(chatId, action, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendChatAction(QVariant chatId, QString action, QDelegate<void(bool)> delegate)
 {
     // param check
-    if(action.isEmpty()) return;
+    if(action.isEmpty()) return (void)delegate.invoke(false);
 
-    QUrlQuery params;
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("action", action);
 
     // call api
-    this->callApiTemplate("sendChatAction", params, response);
+    this->callApiTemplate("sendChatAction", params, delegate);
 }
 
 TelegramBotFile TelegramBot::getFile(QString fileId, bool generateAbsoluteLink)
+{
+    TelegramBotFile file;
+    TelegramBotSyncResponse<TelegramBotFile> sync(&file);
+    this->getFile(fileId, generateAbsoluteLink, sync.delegate());
+    sync.wait();
+    return file;
+}
+
+void TelegramBot::getFile(QString fileId, bool generateAbsoluteLink, QDelegate<void(TelegramBotFile)> delegate)
 {
     // prepare
     QDateTime validUntil = QDateTime::currentDateTime().addSecs(3600);
 
     // build params
-    QUrlQuery params;
+    TelegramBotParams params;
     params.addQueryItem("file_id", fileId);
 
-    // construct TelegramBotFile
-    TelegramBotFile file(this->callApiJson("getFile", params).value("result").toObject());
-    file.validUntil = validUntil;
-    if(generateAbsoluteLink && !file.filePath.isEmpty()) file.link = QString("https://api.telegram.org/file/bot%1/%2").arg(this->apiKey, file.filePath);
-    return file;
+    // construct TelegramBotFile (a local api server returns absolute local paths, which we use as is)
+    QString fileUrl = QString("%1/file/bot%2/").arg(this->apiServer, this->apiKey);
+    bool localMode = this->localMode;
+    this->callApiTemplate("getFile", params, QDelegate<void(TelegramBotFile)>([delegate, validUntil, generateAbsoluteLink, fileUrl, localMode](TelegramBotFile file) mutable {
+        file.validUntil = validUntil;
+        if(generateAbsoluteLink && !file.filePath.isEmpty()) file.link = localMode && QFileInfo(file.filePath).isAbsolute() ? file.filePath : fileUrl + file.filePath;
+        delegate.invoke(file);
+    }));
 }
 
 /*
@@ -103,13 +180,22 @@ TelegramBotFile TelegramBot::getFile(QString fileId, bool generateAbsoluteLink)
  */
 TelegramBotUserProfilePhotos TelegramBot::getUserProfilePhotos(qint32 userId, int offset, int limit)
 {
-    QUrlQuery params;
+    TelegramBotUserProfilePhotos photos;
+    TelegramBotSyncResponse<TelegramBotUserProfilePhotos> sync(&photos);
+    this->getUserProfilePhotos(userId, offset, limit, sync.delegate());
+    sync.wait();
+    return photos;
+}
+
+void TelegramBot::getUserProfilePhotos(qint32 userId, int offset, int limit, QDelegate<void(TelegramBotUserProfilePhotos)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("user_id", QString::number(userId));
     if(offset > 0) params.addQueryItem("offset", QString::number(offset));
     if(limit > 0) params.addQueryItem("limit", QString::number(limit));
 
     // call api and return constructed data
-    return TelegramBotUserProfilePhotos(this->callApiJson("getUserProfilePhotos", params).value("result").toObject());
+    this->callApiTemplate("getUserProfilePhotos", params, delegate);
 }
 
 /*
@@ -117,63 +203,123 @@ TelegramBotUserProfilePhotos TelegramBot::getUserProfilePhotos(qint32 userId, in
  */
 void TelegramBot::kickChatMember(QVariant chatId, qint32 userId, bool *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<bool> sync(response);
+    this->kickChatMember(chatId, userId, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::kickChatMember(QVariant chatId, qint32 userId, QDelegate<void(bool)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("user_id", QString::number(userId));
 
-    this->callApiTemplate("kickChatMember", params, response);
+    this->callApiTemplate("kickChatMember", params, delegate);
 }
 
 void TelegramBot::unbanChatMember(QVariant chatId, qint32 userId, bool *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<bool> sync(response);
+    this->unbanChatMember(chatId, userId, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::unbanChatMember(QVariant chatId, qint32 userId, QDelegate<void(bool)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("user_id", QString::number(userId));
 
-    this->callApiTemplate("unbanChatMember", params, response);
+    this->callApiTemplate("unbanChatMember", params, delegate);
 }
 
 void TelegramBot::leaveChat(QVariant chatId, bool *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<bool> sync(response);
+    this->leaveChat(chatId, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::leaveChat(QVariant chatId, QDelegate<void(bool)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
 
-    this->callApiTemplate("leaveChat", params, response);
+    this->callApiTemplate("leaveChat", params, delegate);
 }
 
 TelegramBotChat TelegramBot::getChat(QVariant chatId)
 {
-    QUrlQuery params;
+    TelegramBotChat chat;
+    TelegramBotSyncResponse<TelegramBotChat> sync(&chat);
+    this->getChat(chatId, sync.delegate());
+    sync.wait();
+    return chat;
+}
+
+void TelegramBot::getChat(QVariant chatId, QDelegate<void(TelegramBotChat)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
 
-    return TelegramBotChat(this->callApiJson("getChat", params).value("result").toObject());
+    this->callApiTemplate("getChat", params, delegate);
 }
 
 QList<TelegramBotChatMember> TelegramBot::getChatAdministrators(QVariant chatId)
 {
-    QUrlQuery params;
+    QList<TelegramBotChatMember> chatMembers;
+    TelegramBotSyncResponse<QList<TelegramBotChatMember>> sync(&chatMembers);
+    this->getChatAdministrators(chatId, sync.delegate());
+    sync.wait();
+    return chatMembers;
+}
+
+void TelegramBot::getChatAdministrators(QVariant chatId, QDelegate<void(QList<TelegramBotChatMember>)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
 
     // call api and parse result
-    QList<TelegramBotChatMember> chatMemebers;
-    JsonHelperT<TelegramBotChatMember>::jsonPathGetArray(this->callApiJson("getChatAdministrators", params), "result", chatMemebers);
-    return chatMemebers;
+    this->callApiJson("getChatAdministrators", params, QDelegate<void(QJsonObject)>([delegate](QJsonObject object) mutable {
+        QList<TelegramBotChatMember> chatMembers;
+        JsonHelperT<TelegramBotChatMember>::jsonPathGetArray(object, "result", chatMembers);
+        delegate.invoke(chatMembers);
+    }));
 }
 
 int TelegramBot::getChatMembersCount(QVariant chatId)
 {
-    QUrlQuery params;
+    int count = 0;
+    TelegramBotSyncResponse<int> sync(&count);
+    this->getChatMembersCount(chatId, sync.delegate());
+    sync.wait();
+    return count;
+}
+
+void TelegramBot::getChatMembersCount(QVariant chatId, QDelegate<void(int)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
-    return this->callApiJson("getChatMembersCount", params).value("result").toInt();
+
+    this->callApiTemplate("getChatMembersCount", params, delegate);
 }
 
 TelegramBotChatMember TelegramBot::getChatMember(QVariant chatId, qint32 userId)
 {
-    QUrlQuery params;
+    TelegramBotChatMember chatMember;
+    TelegramBotSyncResponse<TelegramBotChatMember> sync(&chatMember);
+    this->getChatMember(chatId, userId, sync.delegate());
+    sync.wait();
+    return chatMember;
+}
+
+void TelegramBot::getChatMember(QVariant chatId, qint32 userId, QDelegate<void(TelegramBotChatMember)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("user_id", QString::number(userId));
 
-    return TelegramBotChatMember(this->callApiJson("getChatMember", params).value("result").toObject());
+    this->callApiTemplate("getChatMember", params, delegate);
 }
 
 /*
@@ -181,14 +327,21 @@ TelegramBotChatMember TelegramBot::getChatMember(QVariant chatId, qint32 userId)
  */
 void TelegramBot::answerCallbackQuery(QString callbackQueryId, QString text, bool showAlert, int cacheTime, QString url, bool *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<bool> sync(response);
+    this->answerCallbackQuery(callbackQueryId, text, showAlert, cacheTime, url, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::answerCallbackQuery(QString callbackQueryId, QString text, bool showAlert, int cacheTime, QString url, QDelegate<void(bool)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("callback_query_id", callbackQueryId);
     if(!text.isNull()) params.addQueryItem("text", text);
     if(showAlert) params.addQueryItem("show_alert", "true");
     if(!url.isNull()) params.addQueryItem("url", url);
     if(cacheTime > 0) params.addQueryItem("cache_time", QString::number(cacheTime));
 
-    this->callApiTemplate("answerCallbackQuery", params, response);
+    this->callApiTemplate("answerCallbackQuery", params, delegate);
 }
 
 
@@ -197,7 +350,14 @@ void TelegramBot::answerCallbackQuery(QString callbackQueryId, QString text, boo
  */
 void TelegramBot::sendMessage(QVariant chatId, QString text, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendMessage(chatId, text, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendMessage(QVariant chatId, QString text, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("text", text);
     if(flags && TelegramFlags::Markdown) params.addQueryItem("parse_mode", "Markdown");
@@ -210,7 +370,7 @@ void TelegramBot::sendMessage(QVariant chatId, QString text, int replyToMessageI
     this->hanldeReplyMarkup(params, flags, keyboard);
 
     // call api
-    return this->callApiTemplate("sendMessage", params, response);
+    return this->callApiTemplate("sendMessage", params, delegate);
 }
 
 void TelegramBot::editMessageText(QVariant chatId, QVariant messageId, QString text, TelegramFlags flags, TelegramKeyboardRequest keyboard, bool *response)
@@ -220,10 +380,17 @@ void TelegramBot::editMessageText(QVariant chatId, QVariant messageId, QString t
         return this->sendMessage(chatId, text, 0, flags, keyboard);
     }
 
+    TelegramBotSyncResponse<bool> sync(response);
+    this->editMessageText(chatId, messageId, text, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::editMessageText(QVariant chatId, QVariant messageId, QString text, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate)
+{
     // determine message id type
     bool isInlineMessageId = messageId.type() == QVariant::String;
 
-    QUrlQuery params;
+    TelegramBotParams params;
     if(!isInlineMessageId && !chatId.isNull()) params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem(isInlineMessageId ? "inline_message_id" : "message_id", messageId.toString());
     params.addQueryItem("text", text);
@@ -237,15 +404,22 @@ void TelegramBot::editMessageText(QVariant chatId, QVariant messageId, QString t
     }
 
     // call api
-    this->callApiTemplate("editMessageText", params, response);
+    this->callApiTemplate("editMessageText", params, delegate);
 }
 
 void TelegramBot::editMessageCaption(QVariant chatId, QVariant messageId, QString caption, TelegramKeyboardRequest keyboard, bool *response)
+{
+    TelegramBotSyncResponse<bool> sync(response);
+    this->editMessageCaption(chatId, messageId, caption, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::editMessageCaption(QVariant chatId, QVariant messageId, QString caption, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate)
 {
     // determine message id type
     bool isInlineMessageId = messageId.type() == QVariant::String;
 
-    QUrlQuery params;
+    TelegramBotParams params;
     if(!isInlineMessageId && !chatId.isNull()) params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem(isInlineMessageId ? "inline_message_id" : "message_id", messageId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
@@ -254,15 +428,22 @@ void TelegramBot::editMessageCaption(QVariant chatId, QVariant messageId, QStrin
     this->hanldeReplyMarkup(params, TelegramFlags(), keyboard);
 
     // call api
-    this->callApiTemplate("editMessageCaption", params, response);
+    this->callApiTemplate("editMessageCaption", params, delegate);
 }
 
 void TelegramBot::editMessageReplyMarkup(QVariant chatId, QVariant messageId, TelegramKeyboardRequest keyboard, bool *response)
+{
+    TelegramBotSyncResponse<bool> sync(response);
+    this->editMessageReplyMarkup(chatId, messageId, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::editMessageReplyMarkup(QVariant chatId, QVariant messageId, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate)
 {
     // determine message id type
     bool isInlineMessageId = messageId.type() == QVariant::String;
 
-    QUrlQuery params;
+    TelegramBotParams params;
     if(!isInlineMessageId && !chatId.isNull()) params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem(isInlineMessageId ? "inline_message_id" : "message_id", messageId.toString());
 
@@ -270,27 +451,41 @@ void TelegramBot::editMessageReplyMarkup(QVariant chatId, QVariant messageId, Te
     this->hanldeReplyMarkup(params, TelegramFlags(), keyboard);
 
     // call api
-    this->callApiTemplate("editMessageReplyMarkup", params, response);
+    this->callApiTemplate("editMessageReplyMarkup", params, delegate);
 }
 
 void TelegramBot::forwardMessage(QVariant targetChatId, QVariant fromChatId, qint32 fromMessageId, TelegramFlags flags, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->forwardMessage(targetChatId, fromChatId, fromMessageId, flags, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::forwardMessage(QVariant targetChatId, QVariant fromChatId, qint32 fromMessageId, TelegramFlags flags, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", targetChatId.toString());
     params.addQueryItem("from_chat_id", fromChatId.toString());
     params.addQueryItem("message_id", QString::number(fromMessageId));
     if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
 
-    this->callApiTemplate("forwardMessage", params, response);
+    this->callApiTemplate("forwardMessage", params, delegate);
 }
 
 void TelegramBot::deleteMessage(QVariant chatId, qint32 messageId, bool *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<bool> sync(response);
+    this->deleteMessage(chatId, messageId, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::deleteMessage(QVariant chatId, qint32 messageId, QDelegate<void(bool)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("message_id", QString::number(messageId));
 
-    this->callApiTemplate("deleteMessage", params, response);
+    this->callApiTemplate("deleteMessage", params, delegate);
 }
 
 /*
@@ -298,7 +493,14 @@ void TelegramBot::deleteMessage(QVariant chatId, qint32 messageId, bool *respons
  */
 void TelegramBot::sendPhoto(QVariant chatId, QVariant photo, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendPhoto(chatId, photo, caption, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendPhoto(QVariant chatId, QVariant photo, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
     if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
@@ -311,12 +513,19 @@ void TelegramBot::sendPhoto(QVariant chatId, QVariant photo, QString caption, in
     QHttpMultiPart* multiPart = this->handleFile("photo", photo, params);
 
     // call api
-    this->callApiTemplate("sendPhoto", params, response, multiPart);
+    this->callApiTemplate("sendPhoto", params, delegate, multiPart);
 }
 
 void TelegramBot::sendAudio(QVariant chatId, QVariant audio, QString caption, QString performer, QString title, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendAudio(chatId, audio, caption, performer, title, duration, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendAudio(QVariant chatId, QVariant audio, QString caption, QString performer, QString title, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
     if(duration >= 0) params.addQueryItem("duration", QString::number(duration));
@@ -332,12 +541,19 @@ void TelegramBot::sendAudio(QVariant chatId, QVariant audio, QString caption, QS
     QHttpMultiPart* multiPart = this->handleFile("audio", audio, params);
 
     // call api
-    this->callApiTemplate("sendAudio", params, response, multiPart);
+    this->callApiTemplate("sendAudio", params, delegate, multiPart);
 }
 
 void TelegramBot::sendDocument(QVariant chatId, QVariant document, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendDocument(chatId, document, caption, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendDocument(QVariant chatId, QVariant document, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
     if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
@@ -350,12 +566,19 @@ void TelegramBot::sendDocument(QVariant chatId, QVariant document, QString capti
     QHttpMultiPart* multiPart = this->handleFile("document", document, params);
 
     // call api
-    this->callApiTemplate("sendDocument", params, response, multiPart);
+    this->callApiTemplate("sendDocument", params, delegate, multiPart);
 }
 
 void TelegramBot::sendSticker(QVariant chatId, QVariant sticker, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendSticker(chatId, sticker, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendSticker(QVariant chatId, QVariant sticker, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
     if(replyToMessageId) params.addQueryItem("reply_to_message_id", QString::number(replyToMessageId));
@@ -367,12 +590,19 @@ void TelegramBot::sendSticker(QVariant chatId, QVariant sticker, int replyToMess
     QHttpMultiPart* multiPart = this->handleFile("sticker", sticker, params);
 
     // call api
-    this->callApiTemplate("sendSticker", params, response, multiPart);
+    this->callApiTemplate("sendSticker", params, delegate, multiPart);
 }
 
 void TelegramBot::sendVideo(QVariant chatId, QVariant video, QString caption, int duration, int width, int height, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendVideo(chatId, video, caption, duration, width, height, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendVideo(QVariant chatId, QVariant video, QString caption, int duration, int width, int height, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
     if(duration >= 0) params.addQueryItem("duration", QString::number(duration));
@@ -388,12 +618,19 @@ void TelegramBot::sendVideo(QVariant chatId, QVariant video, QString caption, in
     QHttpMultiPart* multiPart = this->handleFile("video", video, params);
 
     // call api
-    this->callApiTemplate("sendVideo", params, response, multiPart);
+    this->callApiTemplate("sendVideo", params, delegate, multiPart);
 }
 
 void TelegramBot::sendVoice(QVariant chatId, QVariant voice, QString caption, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendVoice(chatId, voice, caption, duration, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendVoice(QVariant chatId, QVariant voice, QString caption, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(!caption.isNull()) params.addQueryItem("caption", caption);
     if(duration >= 0) params.addQueryItem("duration", QString::number(duration));
@@ -407,12 +644,19 @@ void TelegramBot::sendVoice(QVariant chatId, QVariant voice, QString caption, in
     QHttpMultiPart* multiPart = this->handleFile("voice", voice, params);
 
     // call api
-    this->callApiTemplate("sendVoice", params, response, multiPart);
+    this->callApiTemplate("sendVoice", params, delegate, multiPart);
 }
 
 void TelegramBot::sendVideoNote(QVariant chatId, QVariant videoNote, int length, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendVideoNote(chatId, videoNote, length, duration, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendVideoNote(QVariant chatId, QVariant videoNote, int length, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     if(length >= 0) params.addQueryItem("length", QString::number(length));
     if(duration >= 0) params.addQueryItem("duration", QString::number(duration));
@@ -426,12 +670,19 @@ void TelegramBot::sendVideoNote(QVariant chatId, QVariant videoNote, int length,
     QHttpMultiPart* multiPart = this->handleFile("video_note", videoNote, params);
 
     // call api
-    this->callApiTemplate("sendVideoNote", params, response, multiPart);
+    this->callApiTemplate("sendVideoNote", params, delegate, multiPart);
 }
 
 void TelegramBot::sendLocation(QVariant chatId, double latitude, double longitude, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendLocation(chatId, latitude, longitude, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendLocation(QVariant chatId, double latitude, double longitude, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("latitude", QString::number(latitude));
     params.addQueryItem("longitude", QString::number(longitude));
@@ -442,12 +693,19 @@ void TelegramBot::sendLocation(QVariant chatId, double latitude, double longitud
     this->hanldeReplyMarkup(params, flags, keyboard);
 
     // call api
-    this->callApiTemplate("sendLocation", params, response);
+    this->callApiTemplate("sendLocation", params, delegate);
 }
 
 void TelegramBot::sendVenue(QVariant chatId, double latitude, double longitude, QString title, QString address, QString foursquareId, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendVenue(chatId, latitude, longitude, title, address, foursquareId, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendVenue(QVariant chatId, double latitude, double longitude, QString title, QString address, QString foursquareId, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("latitude", QString::number(latitude));
     params.addQueryItem("longitude", QString::number(longitude));
@@ -461,12 +719,19 @@ void TelegramBot::sendVenue(QVariant chatId, double latitude, double longitude,
     this->hanldeReplyMarkup(params, flags, keyboard);
 
     // call api
-    this->callApiTemplate("sendVenue", params, response);
+    this->callApiTemplate("sendVenue", params, delegate);
 }
 
 void TelegramBot::sendContact(QVariant chatId, QString phoneNumber, QString firstName, QString lastName, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, TelegramBotMessage *response)
 {
-    QUrlQuery params;
+    TelegramBotSyncResponse<TelegramBotMessage> sync(response);
+    this->sendContact(chatId, phoneNumber, firstName, lastName, replyToMessageId, flags, keyboard, sync.delegate());
+    sync.wait();
+}
+
+void TelegramBot::sendContact(QVariant chatId, QString phoneNumber, QString firstName, QString lastName, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate)
+{
+    TelegramBotParams params;
     params.addQueryItem("chat_id", chatId.toString());
     params.addQueryItem("phone_number", phoneNumber);
     params.addQueryItem("first_name", firstName);
@@ -478,7 +743,148 @@ void TelegramBot::sendContact(QVariant chatId, QString phoneNumber, QString firs
     this->hanldeReplyMarkup(params, flags, keyboard);
 
     // call api
-    this->callApiTemplate("sendContact", params, response);
+    this->callApiTemplate("sendContact", params, delegate);
+}
+
+/*
+ * Broadcast Functions
+ */
+int TelegramBot::broadcastMessage(QList<QVariant> chatIds, QString text, TelegramFlags flags, TelegramKeyboardRequest keyboard)
+{
+    TelegramBotParams params;
+    params.addQueryItem("text", text);
+    if(flags && TelegramFlags::Markdown) params.addQueryItem("parse_mode", "Markdown");
+    else if(flags && TelegramFlags::Html) params.addQueryItem("parse_mode", "HTML");
+    if(flags && TelegramFlags::DisableWebPagePreview) params.addQueryItem("disable_web_page_preview", "true");
+    if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
+
+    // handle reply markup
+    this->hanldeReplyMarkup(params, flags, keyboard);
+
+    return this->broadcast("sendMessage", chatIds, params);
+}
+
+int TelegramBot::broadcastPhoto(QList<QVariant> chatIds, QVariant photo, QString caption, TelegramFlags flags, TelegramKeyboardRequest keyboard)
+{
+    TelegramBotParams params;
+    if(!caption.isNull()) params.addQueryItem("caption", caption);
+    if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
+
+    // handle reply markup
+    this->hanldeReplyMarkup(params, flags, keyboard);
+
+    return this->broadcast("sendPhoto", chatIds, params, "photo", photo);
+}
+
+int TelegramBot::broadcastDocument(QList<QVariant> chatIds, QVariant document, QString caption, TelegramFlags flags, TelegramKeyboardRequest keyboard)
+{
+    TelegramBotParams params;
+    if(!caption.isNull()) params.addQueryItem("caption", caption);
+    if(flags && TelegramFlags::DisableNotfication) params.addQueryItem("disable_notification", "true");
+
+    // handle reply markup
+    this->hanldeReplyMarkup(params, flags, keyboard);
+
+    return this->broadcast("sendDocument", chatIds, params, "document", document);
+}
+
+void TelegramBot::cancelBroadcast(int broadcastId)
+{
+    // results of requests in flight are ignored
+    Broadcast* broadcast = this->broadcasts.take(broadcastId);
+    if(!broadcast) return;
+    emit this->broadcastFinished(broadcastId, broadcast->sent, broadcast->failed);
+    delete broadcast;
+}
+
+int TelegramBot::broadcast(QString method, QList<QVariant> chatIds, TelegramBotParams params, QString fileField, QVariant file)
+{
+    // construct broadcast, the params are serialized only once for all chats
+    Broadcast* broadcast = new Broadcast;
+    broadcast->method = method;
+    broadcast->chatIds = chatIds;
+    broadcast->params = params;
+    broadcast->fileField = fileField;
+    broadcast->file = file;
+    if(!file.isValid()) broadcast->formBody = this->createFormBody(params);
+
+    // start broadcast (deferred, so that the caller receives the id before any signal)
+    int broadcastId = ++this->broadcastCounter;
+    this->broadcasts.insert(broadcastId, broadcast);
+    QTimer::singleShot(0, this, [this, broadcastId]() { this->processBroadcast(broadcastId); });
+    return broadcastId;
+}
+
+void TelegramBot::processBroadcast(int broadcastId)
+{
+    Broadcast* broadcast = this->broadcasts.value(broadcastId);
+    if(!broadcast) return;
+
+    // queue only a window of requests, until we have the file id only one upload is in flight
+    bool uploading = broadcast->file.isValid() && broadcast->fileId.isEmpty();
+    int window = uploading ? 1 : this->requestConcurrency[TelegramRequestPriority::Bulk] * 2;
+    while(broadcast->inFlight < window && broadcast->next < broadcast->chatIds.size()) {
+        QVariant chatId = broadcast->chatIds.at(broadcast->next++);
+
+        // construct request
+        TelegramBotRequest request(new TelegramBotRequestPrivate);
+        request->method = broadcast->method;
+        request->priority = TelegramRequestPriority::Bulk;
+        request->delegate = QDelegate<void(QJsonObject)>([this, broadcastId, chatId](QJsonObject object) {
+            this->handleBroadcastResult(broadcastId, chatId, object);
+        });
+        if(uploading) {
+            request->params = broadcast->params;
+            request->params.addQueryItem("chat_id", chatId.toString());
+            request->multiPart = this->handleFile(broadcast->fileField, broadcast->file, request->params);
+        } else {
+            request->params.addQueryItem("chat_id", chatId.toString());
+            request->formBody = broadcast->formBody + "&chat_id=" + QUrl::toPercentEncoding(chatId.toString());
+        }
+
+        // queue request
+        broadcast->inFlight++;
+        this->queueRequest(request);
+    }
+
+    // broadcast finished
+    if(!broadcast->inFlight && broadcast->next >= broadcast->chatIds.size()) {
+        this->broadcasts.remove(broadcastId);
+        emit this->broadcastFinished(broadcastId, broadcast->sent, broadcast->failed);
+        delete broadcast;
+    }
+}
+
+void TelegramBot::handleBroadcastResult(int broadcastId, QVariant chatId, QJsonObject object)
+{
+    Broadcast* broadcast = this->broadcasts.value(broadcastId);
+    if(!broadcast) return;
+
+    // count result
+    bool ok = object.value("ok").toBool();
+    QJsonObject oResult = object.value("result").toObject();
+    broadcast->inFlight--;
+    if(ok) broadcast->sent++;
+    else broadcast->failed++;
+
+    // extract file id of the first successful upload and send it to all other chats
+    if(ok && broadcast->file.isValid() && broadcast->fileId.isEmpty()) {
+        QJsonValue fileValue = oResult.value(broadcast->fileField);
+        if(fileValue.isArray()) fileValue = fileValue.toArray().at(fileValue.toArray().size() - 1);
+        broadcast->fileId = fileValue.toObject().value("file_id").toString();
+        if(!broadcast->fileId.isEmpty()) {
+            broadcast->params.addQueryItem(broadcast->fileField, broadcast->fileId);
+            broadcast->formBody = this->createFormBody(broadcast->params);
+        }
+    }
+
+    // inform the outside world (note: the broadcast may be canceled by the receivers)
+    int sent = broadcast->sent, failed = broadcast->failed, total = broadcast->chatIds.size();
+    emit this->broadcastResult(broadcastId, chatId, ok, oResult.value("message_id").toInt(), object.value("description").toString());
+    emit this->broadcastProgress(broadcastId, sent, failed, total);
+
+    // continue broadcast
+    this->processBroadcast(broadcastId);
 }
 
 /*
@@ -486,15 +892,22 @@ void TelegramBot::sendContact(QVariant chatId, QString phoneNumber, QString firs
  */
 void TelegramBot::startMessagePulling(uint timeout, uint limit, TelegramPollMessageTypes messageTypes, long offset)
 {
-    // remove webhook
-    this->deleteWebhookResult();
-
     // build url params
     this->pullParams.clear();
-    if(offset) this->pullParams.addQueryItem("offset", QString::number(offset));
+    if(offset) {
+        this->pullParams.addQueryItem("offset", QString::number(offset));
+        if(offset > 0) this->updateId = this->processedUpdateId = offset - 1;
+    }
     else if(this->updateId) this->pullParams.addQueryItem("offset", QString::number(this->updateId));
+    else if(qint64 storedUpdateId = this->offsetStore ? this->offsetStore->load() : 0) {
+        this->processedUpdateId = storedUpdateId;
+        this->pullParams.addQueryItem("offset", QString::number(storedUpdateId + 1));
+    }
     this->pullParams.addQueryItem("limit",   QString::number(limit));
     this->pullParams.addQueryItem("timeout", QString::number(timeout));
+    this->pullLimit = this->pullLimitMin = limit;
+    this->pullTimeout = this->pullTimeoutMin = timeout;
+    this->pullBatchFull = false;
 
     // allowed updates
     QStringList allowedUpdates;
@@ -509,16 +922,99 @@ void TelegramBot::startMessagePulling(uint timeout, uint limit, TelegramPollMess
     }
     if(!allowedUpdates.isEmpty()) this->pullParams.addQueryItem("allowed_updates", "[\"" + allowedUpdates.join("\",\"") + "\"]");
 
-    // start pulling
-    this->pull();
+    // drain the backlog with maximum batch size and without waiting, until a batch isn't full anymore
+    this->draining = this->drainPolicy == TelegramDrainPolicy::FastDrain || this->drainPolicy == TelegramDrainPolicy::FilteredDrain;
+    if(this->draining) {
+        this->pullParams.removeQueryItem("limit");
+        this->pullParams.removeQueryItem("timeout");
+        this->pullParams.addQueryItem("limit",   "100");
+        this->pullParams.addQueryItem("timeout", "0");
+    }
+
+    // remove webhook and start pulling afterwards
+    this->deleteWebhookResult(QDelegate<void(TelegramBotOperationResult)>([this](TelegramBotOperationResult) {
+        if(this->drainPolicy == TelegramDrainPolicy::SkipToLatest) this->skipToLatestUpdate();
+        else this->pull();
+    }));
 }
 
 void TelegramBot::stopMessagePulling(bool instantly)
 {
     this->pullParams.clear();
+    this->pullWatchdog.stop();
     if(instantly && this->replyPull) this->replyPull->abort();
 }
 
+void TelegramBot::setAdaptivePulling(bool enabled, uint maxTimeout)
+{
+    this->pullAdaptive = enabled;
+    this->pullMaxTimeout = maxTimeout;
+}
+
+void TelegramBot::setOffsetStore(TelegramBotOffsetStore* offsetStore)
+{
+    // the bot takes the ownership of the store
+    if(this->offsetStore != offsetStore) delete this->offsetStore;
+    this->offsetStore = offsetStore;
+}
+
+void TelegramBot::checkpointOffset()
+{
+    // one durable write per pull (or per second without pulling), not per update or received chunk
+    if(this->offsetStore && this->processedUpdateId) this->offsetStore->store(this->processedUpdateId);
+}
+
+void TelegramBot::setStartupDrain(TelegramDrainPolicy policy, uint maxAge)
+{
+    this->drainPolicy = policy;
+    this->drainMaxAge = maxAge;
+}
+
+void TelegramBot::skipToLatestUpdate()
+{
+    // a negative offset returns the latest update, continuing after it discards all older ones
+    TelegramBotParams params;
+    params.addQueryItem("offset",  "-1");
+    params.addQueryItem("limit",   "1");
+    params.addQueryItem("timeout", "0");
+    this->callApiJson("getUpdates", params, QDelegate<void(QJsonObject)>([this](QJsonObject object) {
+        QJsonArray updates = object.value("result").toArray();
+        if(!updates.isEmpty() && !this->pullParams.isEmpty()) {
+            this->updateId = qMax<long>(this->updateId, updates.last().toObject().value("update_id").toVariant().toLongLong());
+            this->processedUpdateId = qMax<qint64>(this->processedUpdateId, this->updateId - 1);
+            this->pullParams.removeQueryItem("offset");
+            this->pullParams.addQueryItem("offset", QString::number(this->updateId + 1));
+            this->enqueueUpdates(QJsonArray({updates.last()}));
+        }
+        this->pull();
+    }));
+}
+
+void TelegramBot::filterStaleUpdates(QJsonArray& updates)
+{
+    // updates without date (inline queries, callback queries, ...) inherit the date of their predecessor (updates are ordered)
+    // Note: the updates of a batch are filtered while they arrive, so the date is kept between the calls
+    qint64 minDate = QDateTime::currentSecsSinceEpoch() - this->drainMaxAge;
+    qint64& date = this->drainLastDate;
+    for(auto itr = updates.begin(); itr != updates.end();) {
+        QJsonObject update = itr->toObject();
+        for(QString type : {"message", "edited_message", "channel_post", "edited_channel_post"}) {
+            QJsonObject message = update.value(type).toObject();
+            if(message.isEmpty()) continue;
+            date = message.value(message.contains("edit_date") ? "edit_date" : "date").toVariant().toLongLong();
+            break;
+        }
+        if(date && date < minDate) itr = updates.erase(itr);
+        else itr++;
+    }
+}
+
+int TelegramBot::updateBacklogEstimate()
+{
+    // updates which wait for processing + (if the last batch was full) at least one more batch on the telegram server
+    return this->updateQueueDepth() + (this->pullBatchFull ? this->pullLimit : 0);
+}
+
 void TelegramBot::pull()
 {
     // if we pull is disabled, exit
@@ -527,31 +1023,690 @@ void TelegramBot::pull()
     // cleanup
     if(this->replyPull) this->replyPull->deleteLater();
 
+    // continue after the received updates, so that the queued ones aren't fetched and decoded again (this confirms them, telegram deletes confirmed updates)
+    // the stored offset only covers processed updates, it's written at the same time
+    this->checkpointOffset();
+    if(this->updateId) {
+        this->pullParams.removeQueryItem("offset");
+        this->pullParams.addQueryItem("offset", QString::number(this->updateId + 1));
+    }
+
     // call api
     this->replyPull = this->callApi("getUpdates", this->pullParams, false);
+    this->pullReader.reset();
+    this->pullBatchSize = 0;
+    QObject::connect(this->replyPull, &QNetworkReply::readyRead, this, &TelegramBot::handlePullData);
     QObject::connect(this->replyPull, &QNetworkReply::finished, this, &TelegramBot::handlePullResponse);
+
+    // after a stall the reconnect is done as soon as the new connection is established (not when the long poll returns, it may wait up to it's timeout)
+    if(this->pullStalledSince) {
+        auto reconnected = [this]() {
+            if(!this->pullStalledSince) return;
+            this->pullLastReconnectTime = QDateTime::currentMSecsSinceEpoch() - this->pullStalledSince;
+            this->pullStalledSince = 0;
+        };
+        QObject::connect(this->replyPull, &QNetworkReply::encrypted, this, reconnected);
+        QObject::connect(this->replyPull, &QNetworkReply::metaDataChanged, this, reconnected);
+    }
+
+    // a pull has to finish within it's timeout (+ grace), otherwise it's treated as stalled
+    if(this->pullWatchdogGrace) this->pullWatchdog.start((this->pullParams.queryItemValue("timeout").toInt() + this->pullWatchdogGrace) * 1000);
+}
+
+void TelegramBot::handlePullStall()
+{
+    // abort the stalled pull, the pull is reissued by the response handler
+    // Note: the cached connections of the puller are dropped, so that the new pull opens a new connection (with http/2 the abort only resets the stream of the dead connection),
+    //       the connections of the other api calls are kept
+    if(!this->replyPull || this->replyPull->isFinished()) return;
+    qWarning("TelegramBot::handlePullStall - getUpdates didn't finish in time, reconnecting...");
+    this->pullStallCount++;
+    this->pullStalledSince = QDateTime::currentMSecsSinceEpoch();
+    this->pullManager.clearConnectionCache();
+    this->replyPull->abort();
+}
+
+void TelegramBot::setPullWatchdog(uint graceSeconds)
+{
+    this->pullWatchdogGrace = graceSeconds;
+    if(!graceSeconds) this->pullWatchdog.stop();
+}
+
+int TelegramBot::pullStalls()
+{
+    return this->pullStallCount;
+}
+
+qint64 TelegramBot::pullReconnectTime()
+{
+    return this->pullLastReconnectTime;
 }
 
 void TelegramBot::handlePullResponse()
 {
-    // remove update id from request
-    this->pullParams.removeQueryItem("offset");
+    // a successful pull after a stall finishes the reconnect (if the connection setup wasn't seen, e.g. without tls)
+    this->pullWatchdog.stop();
+    if(this->pullStalledSince && this->replyPull->error() == QNetworkReply::NoError) {
+        this->pullLastReconnectTime = QDateTime::currentMSecsSinceEpoch() - this->pullStalledSince;
+        this->pullStalledSince = 0;
+    }
+
+    // decode the rest of the batch (the updates which arrived already are queued) and check the answer
+    this->handlePullData();
+    if(this->replyPull->error() == QNetworkReply::NoError) this->recordTraffic(this->pullRecordData, false);
+    this->pullRecordData.clear();
+    QJsonParseError jError;
+    QJsonObject oResult = this->pullReader.envelope(&jError);
+    if(jError.error != QJsonParseError::NoError) {
+        qDebug("TelegramBot::handlePullResponse - Parse Error: %s", qPrintable(jError.errorString()));
+    } else if(!oResult.value("ok").toBool()) {
+        qDebug("TelegramBot::handlePullResponse - Receive Error: %i - %s", oResult.value("error_code").toInt(), qPrintable(oResult.value("description").toString()));
+    }
+    int batchSize = this->pullBatchSize;
+    if(this->replyPull->error() == QNetworkReply::NoError && !this->draining) this->adaptPullParams(batchSize);
+
+    // startup drain: switch to the configured pull params as soon as the backlog is fetched
+    if(this->draining && this->replyPull->error() == QNetworkReply::NoError && batchSize < 100 && !this->pullParams.isEmpty()) {
+        this->draining = false;
+        this->pullParams.removeQueryItem("limit");
+        this->pullParams.removeQueryItem("timeout");
+        this->pullParams.addQueryItem("limit",   QString::number(this->pullLimit));
+        this->pullParams.addQueryItem("timeout", QString::number(this->pullTimeout));
+    }
 
-    // parse response
+    // continue pulling right away (not queued behind the processing of the batch), so the next batch is fetched while this batch is processed
+    // Note: if the update queue is full, pulling is continued as soon as the queue has space again
+    if(this->updateQueueBlocked()) this->pullBlocked = true;
+    else this->pull();
+}
+
+void TelegramBot::handlePullData()
+{
+    // every update is decoded and queued as soon as it's complete, so the first updates of a batch are processed while the rest is still
+    // received and the document of the whole batch is never built (the update id is taken from the raw json, the update is processed later)
     QByteArray data = this->replyPull->readAll();
-    this->parseMessage(data);
+    if(this->trafficRecordFile.isOpen()) this->pullRecordData.append(data);
+    this->pullReader.append(data);
+    QJsonObject update;
+    while(this->pullReader.readNext(update)) {
+        this->pullBatchSize++;
+
+        // skip updates which were received already (e.g. by a stalled pull whose answer arrived after all)
+        qint64 updateId = update.value("update_id").toVariant().toLongLong();
+        if(updateId <= this->updateId) continue;
+        this->updateId = updateId;
+
+        // startup drain: discard stale updates
+        QJsonArray updates({update});
+        if(this->draining && this->drainPolicy == TelegramDrainPolicy::FilteredDrain) this->filterStaleUpdates(updates);
+        if(updates.isEmpty()) this->finishUpdate(updateId);
+        else this->enqueueUpdates(updates);
+    }
+}
+
+void TelegramBot::adaptPullParams(int batchSize)
+{
+    this->pullBatchFull = batchSize >= static_cast<int>(this->pullLimit);
+    if(!this->pullAdaptive || this->pullParams.isEmpty()) return;
+
+    // full batch: there are more updates waiting, so fetch bigger batches (up to the telegram maximum of 100)
+    if(this->pullBatchFull) {
+        this->pullLimit = qMin<uint>(100, this->pullLimit * 2);
+        this->pullTimeout = this->pullTimeoutMin;
+    }
+
+    // empty batch: nothing to do, so wait longer per pull and shrink the batch size back
+    else if(!batchSize) {
+        this->pullLimit = qMax(this->pullLimitMin, this->pullLimit / 2);
+        this->pullTimeout = qMin(this->pullMaxTimeout, qMax<uint>(1, this->pullTimeout * 2));
+    }
+
+    // partial batch: the backlog is processed, so answer new updates with the configured timeout again
+    else this->pullTimeout = this->pullTimeoutMin;
+
+    this->pullParams.removeQueryItem("limit");
+    this->pullParams.removeQueryItem("timeout");
+    this->pullParams.addQueryItem("limit",   QString::number(this->pullLimit));
+    this->pullParams.addQueryItem("timeout", QString::number(this->pullTimeout));
+}
+
+void TelegramBot::processUpdates()
+{
+    // dispatch all pending updates (updates of batches which arrive meanwhile are appended and processed in order)
+    // Note: in multi threaded mode, only as many updates as the queue capacity permits are handed over to the dispatch threads,
+    //       so that the overflow policy still applies to the remaining ones
+    // Note: a handler which waits for a synchronous api call runs a nested event loop, which may call this function again,
+    //       the nested call returns, so that the next updates are processed after the handler returned (in order)
+    this->pendingUpdatesScheduled = false;
+    if(this->processingUpdates) return;
+    this->processingUpdates = true;
+    while(this->pendingUpdateCount() && (this->dispatchExecutors.isEmpty() || !this->updateQueueCapacity || this->updatesInDispatch < this->updateQueueCapacity)) {
+        // weighted round robin: of every (interactive + normal weight) updates, the first ones are taken from the interactive lane (if it isn't empty)
+        int lane = this->updateLanePosition < this->updateLaneWeights[0] ? 0 : 1;
+        if(this->pendingUpdates[lane].isEmpty()) lane = 1 - lane;
+        this->updateLanePosition = (this->updateLanePosition + 1) % (this->updateLaneWeights[0] + this->updateLaneWeights[1]);
+        PendingUpdate pendingUpdate = this->pendingUpdates[lane].takeFirst();
+        this->updateQueueStats.lastWait = QDateTime::currentMSecsSinceEpoch() - pendingUpdate.queued;
+        this->updateQueueStats.maxWait = qMax(this->updateQueueStats.maxWait, this->updateQueueStats.lastWait);
+
+        // save update id (the puller may already have received later updates, replayed updates are never confirmed)
+        qint64 updateId = pendingUpdate.update.value("update_id").toVariant().toLongLong();
+        if(!pendingUpdate.replayed) this->updateId = qMax<long>(this->updateId, updateId);
+
+        // process level distribution: the update is handed over to the worker process of it's chat
+        if(this->distributionServer) {
+            this->distributeUpdate(pendingUpdate.update);
+            this->finishUpdate(updateId, pendingUpdate.replayed);
+            continue;
+        }
+
+        // single threaded dispatch
+        if(this->dispatchExecutors.isEmpty()) {
+            this->dispatchUpdate(pendingUpdate.update);
+            this->finishUpdate(updateId, pendingUpdate.replayed);
+            continue;
+        }
+
+        // multi threaded dispatch: all updates of a chat are handled by the same executor, so they keep their order
+        // Note: the updates are appended to the executor's own queue, which isn't drained again by the nested event loop of a synchronous api call,
+        //       so a waiting handler don't let the next update of it's executor overtake it
+        int executor = qHash(this->updateDispatchKey(pendingUpdate.update)) % this->dispatchExecutors.length();
+        DispatchQueue* queue = this->dispatchQueues.at(executor);
+        this->updatesInDispatch++;
+        QMetaObject::invokeMethod(this->dispatchExecutors.at(executor), [this, queue, pendingUpdate]() {
+            queue->updates.append(pendingUpdate);
+            if(queue->draining) return;
+            queue->draining = true;
+            while(!queue->updates.isEmpty()) {
+                PendingUpdate next = queue->updates.takeFirst();
+                this->dispatchUpdate(next.update);
+                QMetaObject::invokeMethod(this, [this, next]() {
+                    this->updatesInDispatch--;
+                    this->finishUpdate(next.update.value("update_id").toVariant().toLongLong(), next.replayed);
+                    this->processUpdates();
+                }, Qt::QueuedConnection);
+            }
+            queue->draining = false;
+        }, Qt::QueuedConnection);
+    }
+    this->processingUpdates = false;
+
+    // the processed update id only covers updates which are finished (including the ones of all dispatch threads), so it can be stored anytime
+    // Note: while pulling, it's stored by the next pull, otherwise (webhook or distributed updates) at most once per second
+    if(this->pullParams.isEmpty() && !this->offsetCheckpointTimer.isActive()) this->offsetCheckpointTimer.start();
+
+    // the queue has space again, so continue pulling (and replaying)
+    if(this->pullBlocked && !this->updateQueueBlocked()) {
+        this->pullBlocked = false;
+        this->pull();
+    }
+    if(this->trafficReplayBlocked && !this->updateQueueBlocked()) {
+        this->trafficReplayBlocked = false;
+        this->replayNextFrame();
+    }
+    if(this->distributorBlocked && !this->updateQueueBlocked()) {
+        this->distributorBlocked = false;
+        this->readDistributedUpdates();
+    }
+}
+
+/*
+ *  Dispatch functions
+ */
+void TelegramBot::setDispatchThreads(int threads)
+{
+    // the updates which are handed over to the current threads have to be processed first (stopping the threads would drop them)
+    if(this->updatesInDispatch) {
+        return (void)qWarning("TelegramBot::setDispatchThreads - Cannot change the dispatch threads while updates are dispatched...");
+    }
+    this->stopDispatchThreads();
+
+    // start new threads (signals with receivers in other threads are queued, so the update type has to be known)
+    if(threads > 0) qRegisterMetaType<TelegramBotUpdate>("TelegramBotUpdate");
+    for(int i = 0; i < threads; i++) {
+        QThread* thread = new QThread;
+        QObject* executor = new QObject;
+        executor->moveToThread(thread);
+        thread->start();
+        this->dispatchThreads.append(thread);
+        this->dispatchExecutors.append(executor);
+        this->dispatchQueues.append(new DispatchQueue);
+    }
+}
+
+void TelegramBot::stopDispatchThreads()
+{
+    // Note: updates which are still queued for an executor are dropped (only the destructor stops the threads without waiting for them)
+    for(QThread* thread : this->dispatchThreads) {
+        thread->quit();
+        thread->wait();
+    }
+    qDeleteAll(this->dispatchExecutors);
+    qDeleteAll(this->dispatchThreads);
+    qDeleteAll(this->dispatchQueues);
+    this->dispatchExecutors.clear();
+    this->dispatchThreads.clear();
+    this->dispatchQueues.clear();
+    this->updatesInDispatch = 0;
+}
+
+qint64 TelegramBot::updateDispatchKey(QJsonObject& update)
+{
+    // messages and callback queries (of messages) are ordered by chat, everything else by user
+    for(QString type : {"message", "edited_message", "channel_post", "edited_channel_post", "callback_query", "inline_query", "chosen_inline_result"}) {
+        QJsonObject object = update.value(type).toObject();
+        if(object.isEmpty()) continue;
+        QJsonObject chat = (type == "callback_query" ? object.value("message").toObject() : object).value("chat").toObject();
+        return (!chat.isEmpty() ? chat : object.value("from").toObject()).value("id").toVariant().toLongLong();
+    }
+    return 0;
+}
+
+/*
+ *  Distribution functions
+ */
+bool TelegramBot::startUpdateDistribution(QString serverName, int workers)
+{
+    // remove the socket of a crashed distributor and listen for workers
+    this->stopUpdateDistribution();
+    QLocalServer::removeServer(serverName);
+    QScopedPointer<QLocalServer> server(new QLocalServer(this));
+    if(workers < 1 || !server->listen(serverName)) {
+        EXIT_FAILED("TelegramBot::startUpdateDistribution - Cannot listen on \"%s\", distribution disabled...", qPrintable(serverName))
+    }
+    QObject::connect(server.data(), &QLocalServer::newConnection, this, &TelegramBot::handleDistributionConnection);
+    this->distributionServer = server.take();
+    this->distributionWorkers = QVector<QLocalSocket*>(workers, 0);
+    this->distributionBacklog = QVector<QList<PendingUpdate>>(workers);
+    return true;
+}
+
+void TelegramBot::stopUpdateDistribution()
+{
+    // the worker sockets are children of the server (their disconnects during the destruction aren't handled anymore)
+    if(!this->distributionServer) return;
+    for(QLocalSocket* socket : this->distributionServer->findChildren<QLocalSocket*>()) QObject::disconnect(socket, 0, this, 0);
+    delete this->distributionServer;
+    this->distributionServer = 0;
+    this->distributionWorkers.clear();
+    this->distributionBacklog.clear();
+}
+
+void TelegramBot::handleDistributionConnection()
+{
+    while(this->distributionServer->hasPendingConnections()) {
+        QLocalSocket* socket = this->distributionServer->nextPendingConnection();
+
+        // the first frame of a worker is it's index, afterwards the worker only receives
+        QObject::connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            QDataStream stream(socket);
+            stream.startTransaction();
+            qint32 worker = -1;
+            stream >> worker;
+            if(!stream.commitTransaction() || this->distributionWorkers.contains(socket)) return;
+            if(worker < 0 || worker >= this->distributionWorkers.count()) {
+                qWarning("TelegramBot::handleDistributionConnection - Unknown worker %i, connection refused...", worker);
+                return socket->disconnectFromServer();
+            }
+
+            // a reconnected worker replaces it's old connection and receives the updates which were kept meanwhile (as soon as it reads them)
+            if(QLocalSocket* oldSocket = this->distributionWorkers.at(worker)) oldSocket->abort();
+            this->distributionWorkers[worker] = socket;
+            QObject::connect(socket, &QLocalSocket::bytesWritten, this, [this, socket]() {
+                int worker = this->distributionWorkers.indexOf(socket);
+                if(worker >= 0) this->flushDistributionBacklog(worker);
+            });
+            this->flushDistributionBacklog(worker);
+        });
+        QObject::connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            int worker = this->distributionWorkers.indexOf(socket);
+            if(worker >= 0) this->distributionWorkers[worker] = 0;
+            socket->deleteLater();
+        });
+    }
+}
+
+void TelegramBot::distributeUpdate(QJsonObject& update)
+{
+    // frame: length prefixed compact json of one update, all updates of a chat go to the same worker, so they keep their order
+    // Note: a slow worker don't read it's socket, so it's updates are kept like the ones of an unconnected worker once the write buffer is full
+    int worker = qHash(this->updateDispatchKey(update)) % this->distributionWorkers.count();
+    QLocalSocket* socket = this->distributionWorkers.at(worker);
+    if(socket && this->distributionBacklog.at(worker).isEmpty() && !this->distributionSocketFull(socket)) {
+        QDataStream stream(socket);
+        stream << QJsonDocument(update).toJson(QJsonDocument::Compact);
+        return;
+    }
+
+    // the backlog of a worker is limited like the update queue (with BlockPulling the update is kept, but pulling waits for the worker)
+    QList<PendingUpdate>& backlog = this->distributionBacklog[worker];
+    if(this->updateQueueCapacity && backlog.count() >= this->updateQueueCapacity) {
+        if(this->updateQueuePolicy == TelegramOverflowPolicy::DropOldest) {
+            backlog.removeFirst();
+            this->updateQueueStats.dropped++;
+        }
+        else if(this->updateQueuePolicy == TelegramOverflowPolicy::DropByType) {
+            if(this->updateDroppable(update)) return (void)this->updateQueueStats.dropped++;
+            for(int i = 0; i < backlog.count(); i++) {
+                if(!this->updateDroppable(backlog[i].update)) continue;
+                backlog.removeAt(i);
+                this->updateQueueStats.dropped++;
+                break;
+            }
+        }
+    }
+    backlog.append({ update, QDateTime::currentMSecsSinceEpoch(), false });
+}
+
+void TelegramBot::flushDistributionBacklog(int worker)
+{
+    // the kept updates are written as far as the write buffer of the worker permits, the rest waits until the worker read some
+    QLocalSocket* socket = this->distributionWorkers.at(worker);
+    QList<PendingUpdate>& backlog = this->distributionBacklog[worker];
+    if(!socket || backlog.isEmpty()) return;
+    QDataStream stream(socket);
+    while(!backlog.isEmpty() && !this->distributionSocketFull(socket)) stream << QJsonDocument(backlog.takeFirst().update).toJson(QJsonDocument::Compact);
+
+    // a full backlog may have blocked pulling
+    this->processUpdates();
+}
 
-    // add update id to request
-    if(this->updateId) this->pullParams.addQueryItem("offset", QString::number(this->updateId + 1));
+bool TelegramBot::distributionSocketFull(QLocalSocket* socket)
+{
+    // the write buffer of a worker may hold about as many updates as the update queue (estimated with 4 KB per update)
+    return this->updateQueueCapacity && socket->bytesToWrite() >= static_cast<qint64>(this->updateQueueCapacity) * 4096;
+}
+
+void TelegramBot::connectToDistributor(QString serverName, int worker)
+{
+    this->distributorName = serverName;
+    this->distributorWorker = worker;
+    if(!this->distributorSocket) {
+        this->distributorSocket = new QLocalSocket(this);
+        QObject::connect(this->distributorSocket, &QLocalSocket::connected, this, [this]() {
+            QDataStream stream(this->distributorSocket);
+            stream << static_cast<qint32>(this->distributorWorker);
+        });
+        QObject::connect(this->distributorSocket, &QLocalSocket::readyRead, this, &TelegramBot::readDistributedUpdates);
+
+        // the distributor isn't running (yet) or was restarted, so try again later
+        QObject::connect(this->distributorSocket, &QLocalSocket::stateChanged, this, [this](QLocalSocket::LocalSocketState state) {
+            if(state != QLocalSocket::UnconnectedState) return;
+            QTimer::singleShot(1000, this, [this]() {
+                if(this->distributorSocket->state() == QLocalSocket::UnconnectedState) this->distributorSocket->connectToServer(this->distributorName);
+            });
+        });
+    }
+    this->distributorSocket->abort();
+    this->distributorSocket->connectToServer(serverName);
+}
 
-    // continue pulling
-    this->pull();
+void TelegramBot::readDistributedUpdates()
+{
+    // received updates run through the update queue like pulled ones, while the queue is full the socket isn't read anymore
+    QDataStream stream(this->distributorSocket);
+    while(!this->updateQueueBlocked()) {
+        stream.startTransaction();
+        QByteArray frame;
+        stream >> frame;
+        if(!stream.commitTransaction()) return;
+        this->enqueueUpdates(this->parseUpdates(frame, true));
+    }
+    this->distributorBlocked = true;
+}
+
+/*
+ *  Update queue functions
+ */
+void TelegramBot::setUpdateQueue(int capacity, TelegramOverflowPolicy policy, TelegramPollMessageTypes dropTypes)
+{
+    this->updateQueueCapacity = qMax(0, capacity);
+    this->updateQueuePolicy = policy;
+    this->updateQueueDropTypes = dropTypes;
+}
+
+TelegramBot::UpdateQueueMetrics TelegramBot::updateQueueMetrics(bool reset)
+{
+    UpdateQueueMetrics metrics = this->updateQueueStats;
+    metrics.depth = this->updateQueueDepth();
+    if(reset) this->updateQueueStats = { 0, metrics.depth, 0, 0, 0 };
+    return metrics;
+}
+
+bool TelegramBot::enqueueUpdates(QJsonArray updates, bool replayed)
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for(QJsonValue value : updates) {
+        QJsonObject update = value.toObject();
+
+        // handle overflow (with BlockPulling the update is accepted anyway, because it's already received)
+        if(this->updateQueueCapacity && this->pendingUpdateCount() >= this->updateQueueCapacity) {
+            if(this->updateQueuePolicy == TelegramOverflowPolicy::DropOldest) {
+                QList<PendingUpdate>* lane = &this->pendingUpdates[1];
+                if(lane->isEmpty() || (!this->pendingUpdates[0].isEmpty() && this->pendingUpdates[0].first().queued < lane->first().queued)) lane = &this->pendingUpdates[0];
+                PendingUpdate dropped = lane->takeFirst();
+                this->finishUpdate(dropped.update.value("update_id").toVariant().toLongLong(), dropped.replayed);
+                this->updateQueueStats.dropped++;
+            }
+            else if(this->updateQueuePolicy == TelegramOverflowPolicy::DropByType) {
+                if(this->updateDroppable(update)) {
+                    this->finishUpdate(update.value("update_id").toVariant().toLongLong(), replayed);
+                    this->updateQueueStats.dropped++;
+                    continue;
+                }
+
+                // drop the oldest droppable update of both lanes
+                int dropLane = -1;
+                int dropIndex = -1;
+                for(int lane = 0; lane < 2; lane++) {
+                    for(int i = 0; i < this->pendingUpdates[lane].length(); i++) {
+                        if(!this->updateDroppable(this->pendingUpdates[lane][i].update)) continue;
+                        if(dropLane < 0 || this->pendingUpdates[lane].at(i).queued < this->pendingUpdates[dropLane].at(dropIndex).queued) {
+                            dropLane = lane;
+                            dropIndex = i;
+                        }
+                        break;
+                    }
+                }
+                if(dropLane >= 0) {
+                    PendingUpdate dropped = this->pendingUpdates[dropLane].takeAt(dropIndex);
+                    this->finishUpdate(dropped.update.value("update_id").toVariant().toLongLong(), dropped.replayed);
+                    this->updateQueueStats.dropped++;
+                }
+            }
+        }
+        if(!replayed) this->unfinishedUpdates.insert(update.value("update_id").toVariant().toLongLong(), true);
+        this->pendingUpdates[this->updateLane(update)].append({ update, now, replayed });
+    }
+    this->updateQueueStats.maxDepth = qMax(this->updateQueueStats.maxDepth, this->updateQueueDepth());
+
+    // process the updates in the next event loop iteration
+    if(this->pendingUpdateCount() && !this->pendingUpdatesScheduled) {
+        this->pendingUpdatesScheduled = true;
+        QMetaObject::invokeMethod(this, "processUpdates", Qt::QueuedConnection);
+    }
+
+    return !this->updateQueueBlocked();
+}
+
+bool TelegramBot::updateQueueBlocked()
+{
+    if(!this->updateQueueCapacity || this->updateQueuePolicy != TelegramOverflowPolicy::BlockPulling) return false;
+    if(this->updateQueueDepth() >= this->updateQueueCapacity) return true;
+
+    // the distributor also waits while the backlog of an unconnected worker is full
+    for(const QList<PendingUpdate>& backlog : this->distributionBacklog) {
+        if(backlog.count() >= this->updateQueueCapacity) return true;
+    }
+    return false;
+}
+
+int TelegramBot::updateQueueDepth()
+{
+    return this->pendingUpdateCount() + this->updatesInDispatch;
+}
+
+int TelegramBot::pendingUpdateCount()
+{
+    return this->pendingUpdates[0].length() + this->pendingUpdates[1].length();
+}
+
+void TelegramBot::setUpdateLaneWeights(int interactive, int normal)
+{
+    // the normal lane always gets a share, so that it never starves
+    this->updateLaneWeights[0] = qMax(0, interactive);
+    this->updateLaneWeights[1] = qMax(1, normal);
+    this->updateLanePosition = 0;
+}
+
+int TelegramBot::updateLane(QJsonObject& update)
+{
+    // callback queries have to be answered within seconds and inline results get stale fast
+    return this->updateLaneWeights[0] && (update.contains("callback_query") || update.contains("inline_query")) ? 0 : 1;
+}
+
+void TelegramBot::finishUpdate(qint64 updateId, bool replayed)
+{
+    // all updates in front of the first unfinished one are processed (or dropped), replayed updates are never stored
+    if(replayed) return;
+    this->unfinishedUpdates.remove(updateId);
+    this->processedUpdateId = qMax<qint64>(this->processedUpdateId, this->unfinishedUpdates.isEmpty() ? this->updateId : this->unfinishedUpdates.firstKey() - 1);
+}
+
+bool TelegramBot::updateDroppable(QJsonObject& update)
+{
+    TelegramPollMessageTypes dropTypes = this->updateQueueDropTypes;
+    return dropTypes == TelegramPollMessageTypes::All ||
+           (update.contains("message")              && (dropTypes && TelegramPollMessageTypes::Message)) ||
+           (update.contains("edited_message")       && (dropTypes && TelegramPollMessageTypes::EditedMessage)) ||
+           (update.contains("channel_post")         && (dropTypes && TelegramPollMessageTypes::ChannelPost)) ||
+           (update.contains("edited_channel_post")  && (dropTypes && TelegramPollMessageTypes::EditedChannelPost)) ||
+           (update.contains("inline_query")         && (dropTypes && TelegramPollMessageTypes::InlineQuery)) ||
+           (update.contains("chosen_inline_result") && (dropTypes && TelegramPollMessageTypes::ChoosenInlineQuery)) ||
+           (update.contains("callback_query")       && (dropTypes && TelegramPollMessageTypes::CallbackQuery));
+}
+
+/*
+ *  Traffic recording functions
+ */
+bool TelegramBot::startTrafficRecording(QString filePath)
+{
+    // file format: magic, version and afterwards one frame per received payload
+    this->stopTrafficRecording();
+    this->trafficRecordFile.setFileName(filePath);
+    if(!this->trafficRecordFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        EXIT_FAILED("TelegramBot::startTrafficRecording - Cannot open file \"%s\" for writing...", qPrintable(filePath))
+    }
+    this->trafficRecordStream.setDevice(&this->trafficRecordFile);
+    this->trafficRecordStream.setVersion(QDataStream::Qt_5_0);
+    this->trafficRecordStream << static_cast<quint32>(0x54425243) << static_cast<quint8>(1);
+    return true;
+}
+
+void TelegramBot::stopTrafficRecording()
+{
+    if(!this->trafficRecordFile.isOpen()) return;
+    this->trafficRecordStream.setDevice(0);
+    this->trafficRecordFile.close();
+}
+
+void TelegramBot::recordTraffic(QByteArray& data, bool singleMessage)
+{
+    if(!this->trafficRecordFile.isOpen()) return;
+    this->trafficRecordStream << QDateTime::currentMSecsSinceEpoch() << singleMessage << data;
+    if(this->trafficRecordStream.status() != QDataStream::Ok) {
+        qWarning("TelegramBot::recordTraffic - Cannot write file \"%s\", recording stopped...", qPrintable(this->trafficRecordFile.fileName()));
+        this->stopTrafficRecording();
+    }
+}
+
+bool TelegramBot::replayTraffic(QString filePath, double speed)
+{
+    if(this->trafficReplayFile.isOpen()) {
+        EXIT_FAILED("TelegramBot::replayTraffic - A replay is already running...")
+    }
+
+    // open recording and check header
+    this->trafficReplayFile.setFileName(filePath);
+    if(!this->trafficReplayFile.open(QFile::ReadOnly)) {
+        EXIT_FAILED("TelegramBot::replayTraffic - Cannot open file \"%s\"...", qPrintable(filePath))
+    }
+    quint32 magic = 0;
+    quint8 version = 0;
+    this->trafficReplayStream.setDevice(&this->trafficReplayFile);
+    this->trafficReplayStream.setVersion(QDataStream::Qt_5_0);
+    this->trafficReplayStream >> magic >> version;
+    if(magic != 0x54425243 || version != 1) {
+        this->trafficReplayStream.setDevice(0);
+        this->trafficReplayFile.close();
+        EXIT_FAILED("TelegramBot::replayTraffic - File \"%s\" is no traffic recording...", qPrintable(filePath))
+    }
+
+    // start replay
+    this->trafficReplaySpeed = speed;
+    this->trafficReplayFirstFrame = 0;
+    this->trafficReplayUpdates = 0;
+    this->trafficReplayBlocked = false;
+    this->trafficReplayElapsed.start();
+    this->replayNextFrame();
+    return true;
+}
+
+void TelegramBot::replayNextFrame()
+{
+    if(!this->trafficReplayFile.isOpen()) return;
+
+    // the update queue is full, so continue as soon as it has space again
+    if(this->updateQueueBlocked()) return (void)(this->trafficReplayBlocked = true);
+
+    while(!this->trafficReplayStream.atEnd()) {
+        // wait until the frame is due (relative to the first frame and scaled by the speed)
+        qint64 framePosition = this->trafficReplayFile.pos();
+        qint64 recorded = 0;
+        bool singleMessage = false;
+        QByteArray data;
+        this->trafficReplayStream >> recorded;
+        if(!this->trafficReplayFirstFrame) this->trafficReplayFirstFrame = recorded;
+        qint64 delay = this->trafficReplaySpeed > 0 ? static_cast<qint64>((recorded - this->trafficReplayFirstFrame) / this->trafficReplaySpeed) - this->trafficReplayElapsed.elapsed() : 0;
+        if(delay > 0) {
+            this->trafficReplayFile.seek(framePosition);
+            return this->trafficReplayTimer.start(static_cast<int>(delay));
+        }
+        this->trafficReplayStream >> singleMessage >> data;
+        if(this->trafficReplayStream.status() != QDataStream::Ok) {
+            qWarning("TelegramBot::replayNextFrame - File \"%s\" is truncated, replay stopped...", qPrintable(this->trafficReplayFile.fileName()));
+            break;
+        }
+
+        // feed the payload through the same stages as received traffic
+        QJsonArray updates = this->parseUpdates(data, singleMessage);
+        this->trafficReplayUpdates += updates.count();
+        if(!this->enqueueUpdates(updates, true)) return (void)(this->trafficReplayBlocked = true);
+
+        // as fast as possible: let the queued updates be processed before the next frame, so that the queue don't grow without limit
+        if(this->trafficReplaySpeed <= 0) return this->trafficReplayTimer.start(0);
+    }
+
+    // all frames are fed, the replay is finished as soon as all updates are processed
+    if(this->updateQueueDepth()) return (void)(this->trafficReplayBlocked = true);
+    this->trafficReplayStream.setDevice(0);
+    this->trafficReplayFile.close();
+    emit this->trafficReplayFinished(this->trafficReplayUpdates, this->trafficReplayElapsed.elapsed());
 }
 
 /*
  *  Webhook Functions
  */
 bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pathPrivateKey, int maxConnections, TelegramPollMessageTypes messageTypes)
+{
+    bool result = false;
+    TelegramBotSyncResponse<bool> sync(&result);
+    this->setHttpServerWebhook(port, pathCert, pathPrivateKey, maxConnections, messageTypes, sync.delegate());
+    sync.wait();
+    return result;
+}
+
+void TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pathPrivateKey, int maxConnections, TelegramPollMessageTypes messageTypes, QDelegate<void(bool)> delegate)
 {
     // try to acquire httpServer
     HttpServer* httpServer = 0;
@@ -559,17 +1714,17 @@ bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pa
     if(this->webHookWebServers.contains(port)) {
         // if existing webhook contains not the same privateKey, inform user and exit
         if(this->webHookWebServers.find(port).value()->isSamePrivateKey(pathPrivateKey)) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - It's not possible to set multiple private keys for one webserver, webhook installation failed...")
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - It's not possible to set multiple private keys for one webserver, webhook installation failed...")
         }
         httpServer = this->webHookWebServers.find(port).value();
 
         // add new cert
         cert = httpServer->addCert(pathCert);
         if(cert.isNull()) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Cert file %s is invalid, webhook installation failed...", qPrintable(pathCert))
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Cert file %s is invalid, webhook installation failed...", qPrintable(pathCert))
         }
         if(cert.subjectInfo(QSslCertificate::CommonName).isEmpty()) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Cert don't contain a Common Name (CN), webhook installation failed...");
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Cert don't contain a Common Name (CN), webhook installation failed...");
         }
     }
 
@@ -582,13 +1737,13 @@ bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pa
         // handle certificates
         cert = httpServer->addCert(pathCert);
         if(cert.isNull()) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Cert file %s is invalid, webhook installation failed...", qPrintable(pathCert))
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Cert file %s is invalid, webhook installation failed...", qPrintable(pathCert))
         }
         if(cert.subjectInfo(QSslCertificate::CommonName).isEmpty()) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Cert don't contain a Common Name (CN), webhook installation failed...")
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Cert don't contain a Common Name (CN), webhook installation failed...")
         }
         if(!httpServer->setPrivateKey(pathPrivateKey)) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Private Key file %s is invalid, webhook installation failed...", qPrintable(pathPrivateKey))
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Private Key file %s is invalid, webhook installation failed...", qPrintable(pathPrivateKey))
         }
 
         // permit only telegram connections
@@ -596,7 +1751,7 @@ bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pa
 
         // start listener
         if(!httpServer->listen(QHostAddress::Any, port)) {
-            EXIT_FAILED("TelegramBot::setHttpServerWebhook - Cannot listen on port %i, webhook installation failed...", port)
+            EXIT_FAILED_DELEGATE(delegate, "TelegramBot::setHttpServerWebhook - Cannot listen on port %i, webhook installation failed...", port)
         }
 
         // everything is okay, so register http server
@@ -610,7 +1765,7 @@ bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pa
     httpServer->addRewriteRule(host, "/" + this->apiKey, {this, &TelegramBot::handleServerWebhookResponse});
 
     // build server webhook request
-    QUrlQuery query;
+    TelegramBotParams query;
     query.addQueryItem("url", "https://" + host + ":" + QString::number(port) + "/" + this->apiKey);
     if(maxConnections) query.addQueryItem("max_connections", QString::number(maxConnections));
 
@@ -632,7 +1787,7 @@ bool TelegramBot::setHttpServerWebhook(qint16 port, QString pathCert, QString pa
     QHttpMultiPart *multiPart = this->createUploadFile("certificate", "cert.pem", certContent);
 
     // call api
-    return this->callApiJson("setWebhook", query, multiPart).value("result").toBool();
+    this->callApiTemplate("setWebhook", query, delegate, multiPart);
 }
 
 void TelegramBot::deleteWebhook()
@@ -642,12 +1797,33 @@ void TelegramBot::deleteWebhook()
 
 TelegramBotOperationResult TelegramBot::deleteWebhookResult()
 {
-    return TelegramBotOperationResult(this->callApiJson("deleteWebhook"));
+    TelegramBotOperationResult result;
+    TelegramBotSyncResponse<TelegramBotOperationResult> sync(&result);
+    this->deleteWebhookResult(sync.delegate());
+    sync.wait();
+    return result;
+}
+
+void TelegramBot::deleteWebhookResult(QDelegate<void(TelegramBotOperationResult)> delegate)
+{
+    // the operation result is the whole response object, not only the result field
+    this->callApiJson("deleteWebhook", TelegramBotParams(), QDelegate<void(QJsonObject)>([delegate](QJsonObject object) mutable {
+        delegate.invoke(TelegramBotOperationResult(object));
+    }));
 }
 
 TelegramBotWebHookInfo TelegramBot::getWebhookInfo()
 {
-    return TelegramBotWebHookInfo(this->callApiJson("getWebhookInfo").value("result").toObject());
+    TelegramBotWebHookInfo webHookInfo;
+    TelegramBotSyncResponse<TelegramBotWebHookInfo> sync(&webHookInfo);
+    this->getWebhookInfo(sync.delegate());
+    sync.wait();
+    return webHookInfo;
+}
+
+void TelegramBot::getWebhookInfo(QDelegate<void(TelegramBotWebHookInfo)> delegate)
+{
+    this->callApiTemplate("getWebhookInfo", TelegramBotParams(), delegate);
 }
 
 /*
@@ -663,58 +1839,219 @@ void TelegramBot::messageRouterRegister(QString startWith, QDelegate<bool(Telegr
                                });
 }
 
+/*
+ *  Rate limit functions
+ */
+void TelegramBot::setRateLimits(double globalPerSecond, double privateChatPerSecond, double groupChatPerMinute)
+{
+    this->rateLimitGlobal      = { globalPerSecond,                 globalPerSecond / 1000.0 };
+    this->rateLimitPrivateChat = { qMax(1.0, privateChatPerSecond), privateChatPerSecond / 1000.0 };
+    this->rateLimitGroupChat   = { groupChatPerMinute,              groupChatPerMinute / 60000.0 };
+
+    // new limits may unblock queued requests
+    this->processRequestQueue();
+}
+
+/*
+ *  Retry functions
+ */
+void TelegramBot::setRetryPolicy(int maxAttempts, int baseDelay, bool retryNonIdempotent)
+{
+    this->retryMaxAttempts = qMax(1, maxAttempts);
+    this->retryBaseDelay = qMax(1, baseDelay);
+    this->retryNonIdempotent = retryNonIdempotent;
+}
+
+TelegramBotOperationResult TelegramBot::lastCallResult()
+{
+    return this->callResult;
+}
+
+/*
+ *  Request priority functions
+ */
+void TelegramBot::setRequestPriority(TelegramRequestPriority priority)
+{
+    // per thread, so calls of other threads (e.g. dispatch threads) keep their own priority
+    threadRequestPriority = priority;
+}
+
+void TelegramBot::setPriorityConcurrency(TelegramRequestPriority priority, int maxRequests)
+{
+    if(priority == TelegramRequestPriority::InferPriority) return;
+    this->requestConcurrency[priority] = qMax(1, maxRequests);
+
+    // a bigger budget may unblock queued requests
+    this->processRequestQueue();
+}
+
+TelegramBotPriorityScope::TelegramBotPriorityScope(TelegramBot::TelegramRequestPriority priority) : previous(threadRequestPriority)
+{
+    threadRequestPriority = priority;
+}
+
+TelegramBotPriorityScope::~TelegramBotPriorityScope()
+{
+    threadRequestPriority = this->previous;
+}
+
+/*
+ *  Api server functions
+ */
+void TelegramBot::setApiServer(QString apiServer, bool localMode)
+{
+    // remove trailing slashes, so that we can simply append the path
+    while(apiServer.endsWith('/')) apiServer.chop(1);
+    this->apiServer = apiServer;
+    this->localMode = localMode;
+
+    // connect to the new server in advance
+    this->preconnect();
+}
+
+/*
+ *  Trace functions
+ */
+void TelegramBot::setTraceRateLimit(int messagesPerSecond)
+{
+#ifdef TELEGRAMBOT_TRACE
+    this->traceRateLimit = qMax(1, messagesPerSecond);
+#else
+    Q_UNUSED(messagesPerSecond)
+#endif
+}
+
+#ifdef TELEGRAMBOT_TRACE
+void TelegramBot::trace(QString message)
+{
+    // rate limit, messages above the limit are only counted
+    if(this->traceMessages.length() >= this->traceRateLimit) return (void)this->traceDropped++;
+
+    // never write the token into the log (e.g. network error strings contain the url)
+    if(!this->apiKey.isEmpty()) message.replace(this->apiKey, "<token>");
+    this->traceMessages.append(message);
+    if(!this->traceTimer.isActive()) this->traceTimer.start();
+}
+
+void TelegramBot::flushTrace()
+{
+    for(const QString& message : this->traceMessages) qCDebug(telegramBotTrace, "%s", qPrintable(message));
+    if(this->traceDropped) qCDebug(telegramBotTrace, "%i trace messages dropped", this->traceDropped);
+    this->traceMessages.clear();
+    this->traceDropped = 0;
+}
+#endif
+
+/*
+ *  Connection functions
+ */
+void TelegramBot::setHttp2Enabled(bool enabled)
+{
+    this->http2Enabled = enabled;
+
+    // negotiate the new protocol in advance
+    this->preconnect();
+}
+
+void TelegramBot::setConnectionsPerHost(int connections)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 5, 0)
+    qWarning("TelegramBot::setConnectionsPerHost - Qt < 6.5 don't support configurable connection counts, using Qt's default (6)...");
+#endif
+    this->connectionsPerHost = connections;
+}
+
+void TelegramBot::setKeepAliveInterval(uint seconds)
+{
+    if(!seconds) return this->keepAliveTimer.stop();
+    this->keepAliveTimer.start(seconds * 1000);
+}
+
+void TelegramBot::preconnect()
+{
+    // Note: if a connection already exists, this call has no effect, otherwise it reopens the connection
+    QUrl apiServer(this->apiServer);
+    if(apiServer.scheme() != "https") {
+        return this->aManager.connectToHost(apiServer.host(), apiServer.port(80));
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 13, 0)
+    QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+    if(this->http2Enabled) sslConfiguration.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2});
+    this->aManager.connectToHostEncrypted(apiServer.host(), apiServer.port(443), sslConfiguration);
+#else
+    this->aManager.connectToHostEncrypted(apiServer.host(), apiServer.port(443));
+#endif
+}
+
+void TelegramBot::keepAlive()
+{
+    // connecting has no effect on a cached connection (even if the server is about to close it), so an idle connection is kept open by a cheap call
+    if(QDateTime::currentMSecsSinceEpoch() - this->lastRequestTime < this->keepAliveTimer.interval()) return;
+    this->callApi("getMe", TelegramBotParams(), true, 0, TelegramRequestPriority::Bulk);
+}
+
 /*
  * Reponse Parser
  */
 void TelegramBot::parseMessage(QByteArray &data, bool singleMessage)
+{
+    this->enqueueUpdates(this->parseUpdates(data, singleMessage));
+}
+
+QJsonArray TelegramBot::parseUpdates(QByteArray &data, bool singleMessage)
 {
     // parse result
     QJsonParseError jError;
-    QJsonObject oUpdate = QJsonDocument::fromJson(data, &jError).object();
+    QJsonObject oUpdate = JsonHelper::jsonParseObject(data, &jError);
 
     // handle parse error
     if(jError.error != QJsonParseError::NoError) {
-        return (void)qDebug("TelegramBot::parseMessage - Parse Error: %s", qPrintable(jError.errorString()));
+        qDebug("TelegramBot::parseMessage - Parse Error: %s", qPrintable(jError.errorString()));
+        return QJsonArray();
     }
 
     if (!singleMessage && !JsonHelper::jsonPathGet(oUpdate, "ok").toBool()) {
-        return (void)qDebug("TelegramBot::parseMessage - Receive Error: %i - %s",
-                            JsonHelper::jsonPathGet(oUpdate, "error_code").toInt(),
-                            qPrintable(JsonHelper::jsonPathGet(oUpdate, "description").toString()));
-    }
-
-    // loop results
-    for(QJsonValue result : singleMessage ? QJsonArray({oUpdate}) : oUpdate.value("result").toArray()) {
-        QJsonObject update = result.toObject();
-
-        // parse result
-        TelegramBotUpdate updateMessage(new TelegramBotUpdatePrivate);
-        updateMessage->fromJson(update);
-
-        // save update id
-        this->updateId = updateMessage->updateId;
-
-        // send Message to outside world
-        emit this->newMessage(updateMessage);
-
-        // call message routes
-        QString routeData = updateMessage->inlineQuery          ? updateMessage->inlineQuery->query :
-                            updateMessage->chosenInlineResult   ? updateMessage->chosenInlineResult->query :
-                            updateMessage->callbackQuery        ? updateMessage->callbackQuery->data :
-                            updateMessage->message              ? updateMessage->message->text : QString();
-        if(routeData.isNull()) continue;
-        for(auto itrRoute = this->messageRoutes.begin(); itrRoute != this->messageRoutes.end(); itrRoute++) {
-            MessageRoute* route = *itrRoute;
-            if(route->type && updateMessage->type != updateMessage->type) continue;
-            if(!routeData.startsWith(route->startWith)) continue;
-            if(!route->delegate.invoke(updateMessage).first()) break;
-        }
+        qDebug("TelegramBot::parseMessage - Receive Error: %i - %s",
+               JsonHelper::jsonPathGet(oUpdate, "error_code").toInt(),
+               qPrintable(JsonHelper::jsonPathGet(oUpdate, "description").toString()));
+        return QJsonArray();
+    }
+
+    return singleMessage ? QJsonArray({oUpdate}) : oUpdate.value("result").toArray();
+}
+
+void TelegramBot::dispatchUpdate(QJsonObject update)
+{
+    // parse result
+    TelegramBotUpdate updateMessage(new TelegramBotUpdatePrivate);
+    updateMessage->fromJson(update);
+
+    // send Message to outside world
+    emit this->newMessage(updateMessage);
+
+    // call message routes (the route data is read from the raw json, so that unrouted updates are never parsed completely)
+    QString routeData = updateMessage->inlineQuery          ? updateMessage->inlineQuery.json().value("query").toString() :
+                        updateMessage->chosenInlineResult   ? updateMessage->chosenInlineResult.json().value("query").toString() :
+                        updateMessage->callbackQuery        ? updateMessage->callbackQuery.json().value("data").toString() :
+                        updateMessage->message              ? updateMessage->message.json().value("text").toString() : QString();
+    if(routeData.isNull()) return;
+    for(auto itrRoute = this->messageRoutes.begin(); itrRoute != this->messageRoutes.end(); itrRoute++) {
+        MessageRoute* route = *itrRoute;
+        if(route->type && updateMessage->type != updateMessage->type) continue;
+        if(!routeData.startsWith(route->startWith)) continue;
+        if(!route->delegate.invoke(updateMessage).first()) break;
     }
 }
 
 void TelegramBot::handleServerWebhookResponse(HttpServerRequest request, HttpServerResponse response)
 {
+    // if the update queue is full, let telegram redeliver the update later
+    if(this->updateQueueBlocked()) {
+        return (void)(response->status = HttpServerResponsePrivate::Service_Unavailable);
+    }
+
 	// parse response
+    this->recordTraffic(request->content, true);
     this->parseMessage(request->content, true);
 
 	// reply to server with status OK
@@ -726,56 +2063,275 @@ void TelegramBot::handleServerWebhookResponse(HttpServerRequest request, HttpSer
  * Call Api Helpers
  */
 template<typename T>
-typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type TelegramBot::callApiTemplate(QString method, QUrlQuery params, T* response, QHttpMultiPart* multiPart)
+typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type TelegramBot::callApiTemplate(QString method, TelegramBotParams params, QDelegate<void(T)> delegate, QHttpMultiPart* multiPart)
 {
-    // if no response was provided, just call the api
-    if(!response) return (void)this->callApi(method, params, true, multiPart);
-
     // get result and parse it
-    QJsonObject object = QJsonObject(this->callApiJson(method, params, multiPart)).value("result").toObject();
-    response->fromJson(object);
+    this->callApiJson(method, params, QDelegate<void(QJsonObject)>([delegate](QJsonObject object) mutable {
+        T response;
+        QJsonObject oResult = object.value("result").toObject();
+        response.fromJson(oResult);
+        delegate.invoke(response);
+    }), multiPart);
 }
 
 template<typename T>
-typename std::enable_if<!std::is_base_of<TelegramBotObject, T>::value>::type TelegramBot::callApiTemplate(QString method, QUrlQuery params, T* response, QHttpMultiPart* multiPart)
+typename std::enable_if<!std::is_base_of<TelegramBotObject, T>::value>::type TelegramBot::callApiTemplate(QString method, TelegramBotParams params, QDelegate<void(T)> delegate, QHttpMultiPart* multiPart)
 {
-    // if no response was provided, just call the api
-    if(!response) return (void)this->callApi(method, params, true, multiPart);
-
     // get result and (if possible) convert it to T
-    QVariant result = QJsonObject(this->callApiJson(method, params, multiPart)).value("result").toVariant();
-    if(result.canConvert<T>()) *response = result.value<T>();
+    this->callApiJson(method, params, QDelegate<void(QJsonObject)>([delegate](QJsonObject object) mutable {
+        QVariant result = object.value("result").toVariant();
+        delegate.invoke(result.canConvert<T>() ? result.value<T>() : T());
+    }), multiPart);
 }
 
 
-QNetworkReply* TelegramBot::callApi(QString method, QUrlQuery params, bool deleteOnFinish, QHttpMultiPart *multiPart)
+QNetworkReply* TelegramBot::callApi(QString method, TelegramBotParams params, bool deleteOnFinish, QHttpMultiPart *multiPart, TelegramRequestPriority priority, QByteArray formBody)
 {
     // build url
-    QUrl url(QString("https://api.telegram.org/bot%1/%2").arg(this->apiKey, method));
-    url.setQuery(params);
+    QUrl url(QString("%1/bot%2/%3").arg(this->apiServer, this->apiKey, method));
 
-    qDebug() << url;
-
-    // execute
+    // execute (params are send as body, so they are neither limited nor reparsed as url)
     QNetworkRequest request(url);
-    QNetworkReply* reply = multiPart ? this->aManager.post(request, multiPart) : this->aManager.get(request);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, this->http2Enabled);
+    request.setPriority(priority == TelegramRequestPriority::Interactive ? QNetworkRequest::HighPriority :
+                        priority == TelegramRequestPriority::Bulk        ? QNetworkRequest::LowPriority :
+                                                                           QNetworkRequest::NormalPriority);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    QHttp1Configuration http1Configuration;
+    http1Configuration.setNumberOfConnectionsPerHost(this->connectionsPerHost);
+    request.setHttp1Configuration(http1Configuration);
+#endif
+    if(multiPart) this->appendFormFields(params, multiPart);
+    else request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
+    if(!multiPart && formBody.isNull()) formBody = this->createFormBody(params);
+    // long polls run on their own manager (and connection), so a stalled poll can drop it's connections without affecting other calls
+    bool longPoll = method == "getUpdates";
+    QNetworkAccessManager& manager = longPoll ? this->pullManager : this->aManager;
+    QNetworkReply* reply = multiPart ? manager.post(request, multiPart) : manager.post(request, formBody);
+    if(!longPoll) this->lastRequestTime = QDateTime::currentMSecsSinceEpoch();
     if(multiPart) multiPart->setParent(reply);
     if(deleteOnFinish) QObject::connect(reply, &QNetworkReply::finished, reply, &QNetworkReply::deleteLater);
+
+#ifdef TELEGRAMBOT_TRACE
+    // trace method, payload size and latency (but never the url, it contains the token)
+    if(telegramBotTrace().isDebugEnabled()) {
+        QElapsedTimer latency;
+        latency.start();
+        if(multiPart) QObject::connect(reply, &QNetworkReply::uploadProgress, reply, [reply](qint64, qint64 bytesTotal) { reply->setProperty("traceBytesSent", bytesTotal); });
+        // count the received bytes while they arrive (readers like the puller consume them before the reply finishes)
+        QObject::connect(reply, &QNetworkReply::downloadProgress, reply, [reply](qint64 bytesReceived, qint64) { reply->setProperty("traceBytesReceived", bytesReceived); });
+        qint64 bytesSent = formBody.size();
+        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, method, latency, bytesSent]() {
+            this->trace(QString("%1 - sent: %2 bytes, received: %3 bytes, status: %4, latency: %5 ms%6")
+                        .arg(method)
+                        .arg(reply->property("traceBytesSent").isValid() ? reply->property("traceBytesSent").toLongLong() : bytesSent)
+                        .arg(reply->property("traceBytesReceived").toLongLong())
+                        .arg(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
+                        .arg(latency.elapsed())
+                        .arg(reply->error() != QNetworkReply::NoError ? ", error: " + reply->errorString() : QString()));
+        });
+    }
+#endif
+
     return reply;
 }
 
-QJsonObject TelegramBot::callApiJson(QString method, QUrlQuery params, QHttpMultiPart *multiPart)
+void TelegramBot::callApiJson(QString method, TelegramBotParams params, QDelegate<void(QJsonObject)> delegate, QHttpMultiPart *multiPart, TelegramRequestPriority priority)
+{
+    // the priority is determined in the calling thread, so a forwarded call keeps the priority of it's caller
+    if(priority == TelegramRequestPriority::InferPriority) priority = threadRequestPriority;
+    if(priority == TelegramRequestPriority::InferPriority) {
+        priority = method.startsWith("answer") || method == "sendChatAction" ? TelegramRequestPriority::Interactive : TelegramRequestPriority::Normal;
+    }
+
+    // calls from dispatch threads are forwarded to the bot's thread (the network access manager isn't thread safe)
+    if(QThread::currentThread() != this->thread()) {
+        if(multiPart) multiPart->moveToThread(this->thread());
+        return (void)QMetaObject::invokeMethod(this, [this, method, params, delegate, multiPart, priority]() {
+            this->callApiJson(method, params, delegate, multiPart, priority);
+        }, Qt::QueuedConnection);
+    }
+
+    // coalesce identical read calls: if the same call is already pending, just wait for it's answer
+    QString coalesceKey;
+    if(!multiPart && (method == "getChat" || method == "getChatMember" || method == "getChatAdministrators" || method == "getFile")) {
+        coalesceKey = method + "?" + this->createFormBody(params);
+        auto itr = this->pendingReads.find(coalesceKey);
+        if(itr != this->pendingReads.end()) return itr->append(delegate);
+        this->pendingReads.insert(coalesceKey, {delegate});
+        delegate = QDelegate<void(QJsonObject)>([this, coalesceKey](QJsonObject object) {
+            for(auto delegate : this->pendingReads.take(coalesceKey)) delegate.invoke(object);
+        });
+    }
+
+    // construct request
+    TelegramBotRequest request(new TelegramBotRequestPrivate);
+    request->method = method;
+    request->params = params;
+    request->multiPart = multiPart;
+    request->delegate = delegate;
+    request->priority = priority;
+
+    // queue request
+    this->queueRequest(request);
+}
+
+void TelegramBot::queueRequest(TelegramBotRequest request)
+{
+    // params of multipart requests are part of the multipart body (so that a resend don't add them twice)
+    if(request->multiPart) this->appendFormFields(request->params, request->multiPart);
+
+    // only messages are flood controlled by telegram
+    request->rateLimited = request->method.startsWith("send") || request->method.startsWith("forward") || request->method.startsWith("edit");
+    request->chatId = request->params.queryItemValue("chat_id");
+    request->groupChat = request->chatId.startsWith('-') || request->chatId.startsWith('@');
+
+    // queue request, it's send as soon as the rate limits and the concurrency budget of it's priority permit it
+    this->requestQueues[request->priority].append(request);
+    this->processRequestQueue();
+}
+
+void TelegramBot::processRequestQueue()
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 nextRun = -1;
+    QSet<QString> blockedChats;
+
+    // process lanes in priority order, so that interactive requests get the rate limit tokens first
+    for(int priority = TelegramRequestPriority::Interactive; priority <= TelegramRequestPriority::Bulk; priority++) {
+        QList<TelegramBotRequest>& requestQueue = this->requestQueues[priority];
+        for(auto itr = requestQueue.begin(); itr != requestQueue.end() && this->requestsInFlight[priority] < this->requestConcurrency[priority];) {
+            TelegramBotRequest request = *itr;
+
+            // check rate limits (requests of a blocked chat have to wait for their predecessors, to keep the chat order)
+            qint64 delay = qMax<qint64>(0, request->notBefore - now);
+            if(request->rateLimited) {
+                delay = qMax(delay, this->rateBucketDelay(this->rateBucketGlobal, this->rateLimitGlobal, now));
+                RateBucket* bucketChat = 0;
+                if(!request->chatId.isEmpty()) {
+                    bucketChat = &this->rateBucketsChat[request->chatId];
+                    bucketChat->groupChat = request->groupChat;
+                    delay = qMax(delay, this->rateBucketDelay(*bucketChat, request->groupChat ? this->rateLimitGroupChat : this->rateLimitPrivateChat, now));
+                }
+                if(delay > 0 || blockedChats.contains(request->chatId)) {
+                    if(!request->chatId.isEmpty()) blockedChats.insert(request->chatId);
+                    if(delay > 0) nextRun = nextRun < 0 ? delay : qMin(nextRun, delay);
+                    itr++;
+                    continue;
+                }
+
+                // consume tokens
+                if(this->rateLimitGlobal.tokensPerMs > 0) this->rateBucketGlobal.tokens--;
+                if(bucketChat && (request->groupChat ? this->rateLimitGroupChat : this->rateLimitPrivateChat).tokensPerMs > 0) bucketChat->tokens--;
+            }
+
+            // not rate limited requests only wait for their own flood control delay
+            else if(delay > 0) {
+                nextRun = nextRun < 0 ? delay : qMin(nextRun, delay);
+                itr++;
+                continue;
+            }
+
+            // send request
+            itr = requestQueue.erase(itr);
+            this->sendRequest(request);
+        }
+    }
+
+    // cleanup idle chat buckets (a refilled and unpaused bucket is equal to a new one)
+    if(this->rateBucketsChat.size() > 1024) {
+        for(auto itr = this->rateBucketsChat.begin(); itr != this->rateBucketsChat.end();) {
+            const RateLimit& limit = itr->groupChat ? this->rateLimitGroupChat : this->rateLimitPrivateChat;
+            bool idle = !blockedChats.contains(itr.key()) && !this->rateBucketDelay(*itr, limit, now) && itr->tokens >= limit.capacity;
+            if(idle) itr = this->rateBucketsChat.erase(itr);
+            else itr++;
+        }
+    }
+
+    // wake up as soon as the next blocked request may be send
+    if(nextRun > 0) this->requestTimer.start(static_cast<int>(nextRun));
+}
+
+qint64 TelegramBot::rateBucketDelay(RateBucket &bucket, const RateLimit &limit, qint64 now)
 {
-    // exec request
-    QNetworkReply* reply = this->callApi(method, params, true, multiPart);
+    // disabled limit
+    if(limit.tokensPerMs <= 0) return 0;
 
-    // wait async for answer
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+    // refill bucket
+    bucket.tokens = qMin(limit.capacity, bucket.tokens + (now - bucket.lastRefill) * limit.tokensPerMs);
+    bucket.lastRefill = now;
 
-    // parse answer
-    return QJsonDocument::fromJson(reply->readAll()).object();
+    // paused by flood control or empty
+    if(bucket.pausedUntil > now) return bucket.pausedUntil - now;
+    return bucket.tokens >= 1 ? 0 : qCeil((1 - bucket.tokens) / limit.tokensPerMs);
+}
+
+void TelegramBot::sendRequest(TelegramBotRequest request)
+{
+    // exec request (the request owns the multipart, so that it survives a resend)
+    QNetworkReply* reply = this->callApi(request->method, request->multiPart ? TelegramBotParams() : request->params, true, request->multiPart, static_cast<TelegramRequestPriority>(request->priority), request->formBody);
+    if(request->multiPart) request->multiPart->setParent(0);
+    this->requestsInFlight[request->priority]++;
+
+    // parse answer as soon as it arrives (the reply is deleted later, so it's still valid here)
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() {
+        QJsonParseError jError;
+        QJsonObject object = JsonHelper::jsonParseObject(reply->readAll(), &jError);
+        this->requestsInFlight[request->priority]--;
+
+        // handle transient failures (network errors, 5xx or unparsable answers)
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if(jError.error != QJsonParseError::NoError || httpStatus >= 500) {
+            // send and forward calls are only repeated if the request surely never reached telegram (or if the user permits it)
+            QNetworkReply::NetworkError error = reply->error();
+            bool notDelivered = error == QNetworkReply::ConnectionRefusedError ||
+                                error == QNetworkReply::HostNotFoundError ||
+                                error == QNetworkReply::TemporaryNetworkFailureError ||
+                                error == QNetworkReply::NetworkSessionFailedError ||
+                                error == QNetworkReply::SslHandshakeFailedError;
+            bool idempotent = !request->method.startsWith("send") && !request->method.startsWith("forward");
+            if(request->attempts < this->retryMaxAttempts && error != QNetworkReply::OperationCanceledError && (notDelivered || idempotent || this->retryNonIdempotent)) {
+                // exponential backoff with jitter (0.5 - 1.5 of the delay), the shift is clamped so that it can't overflow with many attempts
+                qint64 delay = qMin<qint64>(static_cast<qint64>(this->retryBaseDelay) << qMin(request->attempts - 1, 15), 30000);
+                delay = delay / 2 + QRandomGenerator::global()->bounded(static_cast<int>(delay) + 1);
+                request->notBefore = QDateTime::currentMSecsSinceEpoch() + delay;
+                request->attempts++;
+                this->requestQueues[request->priority].prepend(request);
+                return this->processRequestQueue();
+            }
+
+            // give up, and report a telegram like error to the delegate (instead of an empty object)
+            if(object.isEmpty()) {
+                object.insert("ok", false);
+                object.insert("error_code", httpStatus);
+                object.insert("description", error != QNetworkReply::NoError ? reply->errorString() : jError.errorString());
+            }
+        }
+        object.insert("attempts", request->attempts);
+
+        // handle flood control: pause the affected bucket and resend the request afterwards
+        TelegramBotResponseParameters parameters;
+        JsonHelperT<TelegramBotResponseParameters>::jsonPathGet(object, "parameters", parameters, false);
+        if(object.value("error_code").toInt() == 429 && parameters.retryAfter > 0) {
+            request->notBefore = QDateTime::currentMSecsSinceEpoch() + parameters.retryAfter * 1000;
+            if(request->rateLimited) {
+                RateBucket& bucket = !request->chatId.isEmpty() ? this->rateBucketsChat[request->chatId] : this->rateBucketGlobal;
+                bucket.pausedUntil = request->notBefore;
+            }
+            this->requestQueues[request->priority].prepend(request);
+            return this->processRequestQueue();
+        }
+
+        // typed delegates only see the result, so the outcome of the call is provided by lastCallResult while they run
+        this->callResult.result = object.value("ok").toBool();
+        this->callResult.errorCode = object.value("error_code").toInt();
+        this->callResult.description = object.value("description").toString();
+        this->callResult.attempts = request->attempts;
+
+        // the budget of the request's lane is free again
+        request->delegate.invoke(object);
+        this->processRequestQueue();
+    });
 }
 
 QHttpMultiPart* TelegramBot::createUploadFile(QString name, QString fileName, QByteArray &content, bool detectMimeType, QHttpMultiPart *multiPart)
@@ -793,7 +2349,28 @@ QHttpMultiPart* TelegramBot::createUploadFile(QString name, QString fileName, QB
     return multiPart;
 }
 
-void TelegramBot::hanldeReplyMarkup(QUrlQuery& params, TelegramFlags flags, TelegramKeyboardRequest &keyboard)
+QByteArray TelegramBot::createFormBody(TelegramBotParams &params)
+{
+    // build application/x-www-form-urlencoded body directly from the decoded params (every reserved character including '+' is encoded)
+    QByteArray body;
+    for(const QPair<QString, QString>& param : params) {
+        if(!body.isEmpty()) body += '&';
+        body += QUrl::toPercentEncoding(param.first) + '=' + QUrl::toPercentEncoding(param.second);
+    }
+    return body;
+}
+
+void TelegramBot::appendFormFields(TelegramBotParams &params, QHttpMultiPart *multiPart)
+{
+    for(const QPair<QString, QString>& param : params) {
+        QHttpPart fieldPart;
+        fieldPart.setHeader(QNetworkRequest::ContentDispositionHeader, QString("form-data; name=\"%1\"").arg(param.first));
+        fieldPart.setBody(param.second.toUtf8());
+        multiPart->append(fieldPart);
+    }
+}
+
+void TelegramBot::hanldeReplyMarkup(TelegramBotParams& params, TelegramFlags flags, TelegramKeyboardRequest &keyboard)
 {
     // handle types
     QString replyMarkup;
@@ -849,7 +2426,7 @@ void TelegramBot::hanldeReplyMarkup(QUrlQuery& params, TelegramFlags flags, Tele
     if(!replyMarkup.isEmpty()) params.addQueryItem("reply_markup", replyMarkup);
 }
 
-QHttpMultiPart* TelegramBot::handleFile(QString fieldName, QVariant file, QUrlQuery &params, QHttpMultiPart* multiPart)
+QHttpMultiPart* TelegramBot::handleFile(QString fieldName, QVariant file, TelegramBotParams &params, QHttpMultiPart* multiPart)
 {
     // handle content
     if(file.type() == QVariant::ByteArray) {
@@ -861,8 +2438,18 @@ QHttpMultiPart* TelegramBot::handleFile(QString fieldName, QVariant file, QUrlQu
     else if(file.type() == QVariant::String) {
         QUrl url = QUrl::fromUserInput(file.toString());
 
+        // a local api server reads local files on it's own, so just pass the absolute path
+        if(this->localMode && (url.isLocalFile() || url.isRelative())) {
+            QFileInfo fInfo(file.toString());
+            if(!fInfo.exists()) {
+                qWarning("TelegramBot::handleFile - Cannot find file \"%s\"", qPrintable(file.toString()));
+                return multiPart;
+            }
+            params.addQueryItem(fieldName, QUrl::fromLocalFile(fInfo.absoluteFilePath()).toString());
+        }
+
         // upload the local file to telegram
-        if(url.isLocalFile() || url.isRelative()) {
+        else if(url.isLocalFile() || url.isRelative()) {
             QFile fFile(file.toString());
             if(!fFile.open(QFile::ReadOnly)) {
                 qWarning("TelegramBot::handleFile - Cannot open file \"%s\"", qPrintable(file.toString()));
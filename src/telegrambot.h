@@ -3,11 +3,21 @@
 
 #include <QDebug>
 #include <QTimer>
+#include <QDateTime>
+#include <QSharedPointer>
+#include <QSet>
+#include <QMap>
+#include <QtMath>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QThread>
 
 #include <QObject>
 #include <QVariant>
 #include <QEventLoop>
 #include <QFile>
+#include <QDataStream>
 #include <QFileInfo>
 #include <QMimeDatabase>
 
@@ -15,7 +25,13 @@
 
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QHttpMultiPart>
+#include <QSslConfiguration>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+#include <QHttp1Configuration>
+#endif
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -25,11 +41,92 @@
 
 #include "jsonhelper.h"
 #include "telegramdatastructs.h"
+#include "telegrambotoffsetstore.h"
 
 #include "httpserver.h"
 
+// Request tracing (compiled in with CONFIG += telegrambot_trace, enabled with QT_LOGGING_RULES="telegrambot.trace.debug=true")
+Q_DECLARE_LOGGING_CATEGORY(telegramBotTrace)
+
 // Helper Macros
 #define EXIT_FAILED(...) qWarning(__VA_ARGS__); return false;
+#define EXIT_FAILED_DELEGATE(delegate, ...) qWarning(__VA_ARGS__); return (void)delegate.invoke(false);
+
+// TelegramBotSyncResponse - waits for the delegate of an async api call (only if a response was requested)
+// Note: this starts a nested event loop, so prefer the async api functions in performance critical code
+template<typename T>
+class TelegramBotSyncResponse
+{
+    public:
+        TelegramBotSyncResponse(T* response) : response(response) { }
+
+        QDelegate<void(T)> delegate()
+        {
+            // if no response was requested, we don't wait, so don't reference this (possibly destroyed) object
+            if(!this->response) return QDelegate<void(T)>([](T) { });
+            // Note: the delegate is invoked in the bot's thread, so the loop (maybe running in a dispatch thread) is quit by an event
+            return QDelegate<void(T)>([this](T result) {
+                *this->response = result;
+                this->finished.storeRelease(1);
+                QMetaObject::invokeMethod(&this->loop, "quit", Qt::QueuedConnection);
+            });
+        }
+
+        void wait()
+        {
+            if(this->response && !this->finished.loadAcquire()) this->loop.exec();
+        }
+
+    private:
+        Q_DISABLE_COPY(TelegramBotSyncResponse)
+        T* response;
+        QAtomicInt finished = 0;
+        QEventLoop loop;
+};
+
+// TelegramBotParams - This object represents the parameters of an api call
+// the names and values are kept decoded and are encoded only once, directly into the request body
+class TelegramBotParams : public QList<QPair<QString, QString>>
+{
+    public:
+        TelegramBotParams() {}
+        TelegramBotParams(const QUrlQuery& query) : QList<QPair<QString, QString>>(query.queryItems(QUrl::FullyDecoded)) {} // compatibility with QUrlQuery based code
+
+        void addQueryItem(const QString& name, const QString& value) { this->append(qMakePair(name, value)); }
+        void removeQueryItem(const QString& name)
+        {
+            for(int i = this->size() - 1; i >= 0; i--) if(this->at(i).first == name) this->removeAt(i);
+        }
+        QString queryItemValue(const QString& name) const
+        {
+            for(const QPair<QString, QString>& param : *this) if(param.first == name) return param.second;
+            return QString();
+        }
+};
+
+// TelegramBotRequestPrivate - This object represents a queued api request
+struct TelegramBotRequestPrivate
+{
+    QString method;
+    TelegramBotParams params;
+    QByteArray formBody; // optional pre serialized params (used instead of params)
+    QHttpMultiPart* multiPart = 0;
+    QDelegate<void(QJsonObject)> delegate;
+    int priority; // TelegramBot::TelegramRequestPriority
+    int attempts = 1;
+
+    // rate limit data
+    qint64 notBefore = 0;
+    bool rateLimited = false;
+    QString chatId;
+    bool groupChat = false;
+
+    ~TelegramBotRequestPrivate()
+    {
+        if(this->multiPart) this->multiPart->deleteLater();
+    }
+};
+typedef QSharedPointer<TelegramBotRequestPrivate> TelegramBotRequest;
 
 class TelegramBot : public QObject
 {
@@ -37,6 +134,14 @@ class TelegramBot : public QObject
     signals:
         void newMessage(TelegramBotUpdate message);
 
+        // broadcast signals
+        void broadcastResult(int broadcastId, QVariant chatId, bool ok, qint32 messageId, QString errorDescription);
+        void broadcastProgress(int broadcastId, int sent, int failed, int total);
+        void broadcastFinished(int broadcastId, int sent, int failed);
+
+        // traffic replay signals (elapsed: ms from the start of the replay until the last update is processed)
+        void trafficReplayFinished(int updates, qint64 elapsed);
+
     public:
         enum TelegramPollMessageTypes
         {
@@ -75,6 +180,38 @@ class TelegramBot : public QObject
             ForceReply                   = 1 << 9
         };
 
+        enum TelegramRequestPriority
+        {
+            InferPriority   = -1, // Interactive for answer* and sendChatAction, Normal for everything else
+            Interactive     = 0,
+            Normal          = 1,
+            Bulk            = 2
+        };
+
+        enum TelegramDrainPolicy
+        {
+            NoDrain         = 0, // process the backlog like new updates
+            SkipToLatest    = 1, // discard the backlog, except the latest update
+            FastDrain       = 2, // fetch the backlog with maximum batch size and without waiting
+            FilteredDrain   = 3  // like FastDrain, but discard updates which are older than the max age
+        };
+
+        enum TelegramOverflowPolicy
+        {
+            BlockPulling    = 0, // stop pulling (webhook: let telegram redeliver) until the queue has space again
+            DropOldest      = 1, // drop the oldest queued update
+            DropByType      = 2  // drop updates of the given types (oldest first), other types are never dropped
+        };
+
+        struct UpdateQueueMetrics
+        {
+            int depth;          // updates which currently wait for processing
+            int maxDepth;       // highest depth since the last reset
+            int dropped;        // dropped updates since the last reset
+            qint64 lastWait;    // queue wait time of the last processed update (ms)
+            qint64 maxWait;     // highest queue wait time since the last reset (ms)
+        };
+
 		// Keyboard construction helpers
         static inline TelegramBotKeyboardButtonRequest constructTextButton(QString text, bool requestContact = false, bool requestLocation = false){
             return TelegramBotKeyboardButtonRequest { text, QString(), QString(), QString(), QString(), requestContact, requestLocation };
@@ -89,62 +226,159 @@ class TelegramBot : public QObject
 
         // Bot Functions
         TelegramBotUser getMe();
+        void getMe(QDelegate<void(TelegramBotUser)> delegate);
         void sendChatAction(QVariant chatId, TelegramBotChatAction action, bool* response = 0);
+        void sendChatAction(QVariant chatId, TelegramBotChatAction action, QDelegate<void(bool)> delegate);
         void sendChatAction(QVariant chatId, QString action, bool* response = 0);
+        void sendChatAction(QVariant chatId, QString action, QDelegate<void(bool)> delegate);
         TelegramBotFile getFile(QString fileId, bool generateAbsoluteLink = false);
+        void getFile(QString fileId, bool generateAbsoluteLink, QDelegate<void(TelegramBotFile)> delegate);
 
         // User Functions
         TelegramBotUserProfilePhotos getUserProfilePhotos(qint32 userId, int offset = 0, int limit = 0);
+        void getUserProfilePhotos(qint32 userId, int offset, int limit, QDelegate<void(TelegramBotUserProfilePhotos)> delegate);
 
         // Chat Functions
         void kickChatMember(QVariant chatId, qint32 userId, bool* response = 0);
+        void kickChatMember(QVariant chatId, qint32 userId, QDelegate<void(bool)> delegate);
         void unbanChatMember(QVariant chatId, qint32 userId, bool* response = 0);
+        void unbanChatMember(QVariant chatId, qint32 userId, QDelegate<void(bool)> delegate);
         void leaveChat(QVariant chatId, bool* response = 0);
+        void leaveChat(QVariant chatId, QDelegate<void(bool)> delegate);
         TelegramBotChat getChat(QVariant chatId);
+        void getChat(QVariant chatId, QDelegate<void(TelegramBotChat)> delegate);
         QList<TelegramBotChatMember> getChatAdministrators(QVariant chatId);
+        void getChatAdministrators(QVariant chatId, QDelegate<void(QList<TelegramBotChatMember>)> delegate);
         int getChatMembersCount(QVariant chatId);
+        void getChatMembersCount(QVariant chatId, QDelegate<void(int)> delegate);
         TelegramBotChatMember getChatMember(QVariant chatId, qint32 userId);
+        void getChatMember(QVariant chatId, qint32 userId, QDelegate<void(TelegramBotChatMember)> delegate);
 
         // Callback Query Functions
         void answerCallbackQuery(QString callbackQueryId, QString text = QString(), bool showAlert = false, int cacheTime = 0, QString url = QString(), bool* response = 0);
+        void answerCallbackQuery(QString callbackQueryId, QString text, bool showAlert, int cacheTime, QString url, QDelegate<void(bool)> delegate);
 
         // Message Functions
         void sendMessage(QVariant chatId, QString text, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendMessage(QVariant chatId, QString text, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void editMessageText(QVariant chatId, QVariant messageId, QString text, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), bool* response = 0);
+        void editMessageText(QVariant chatId, QVariant messageId, QString text, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate);
         void editMessageCaption(QVariant chatId, QVariant messageId, QString caption = QString(), TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), bool* response = 0);
+        void editMessageCaption(QVariant chatId, QVariant messageId, QString caption, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate);
         void editMessageReplyMarkup(QVariant chatId, QVariant messageId, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), bool* response = 0);
+        void editMessageReplyMarkup(QVariant chatId, QVariant messageId, TelegramKeyboardRequest keyboard, QDelegate<void(bool)> delegate);
         void forwardMessage(QVariant targetChatId, QVariant fromChatId, qint32 fromMessageId, TelegramFlags flags = TelegramFlags::NoFlag, TelegramBotMessage* response = 0);
+        void forwardMessage(QVariant targetChatId, QVariant fromChatId, qint32 fromMessageId, TelegramFlags flags, QDelegate<void(TelegramBotMessage)> delegate);
         void deleteMessage(QVariant chatId, qint32 messageId, bool* response = 0);
+        void deleteMessage(QVariant chatId, qint32 messageId, QDelegate<void(bool)> delegate);
 
         // Content Functions
         void sendPhoto(QVariant chatId, QVariant photo, QString caption = QString(), int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendPhoto(QVariant chatId, QVariant photo, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendAudio(QVariant chatId, QVariant audio, QString caption = QString(), QString performer = QString(), QString title = QString(), int duration = -1, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendAudio(QVariant chatId, QVariant audio, QString caption, QString performer, QString title, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendDocument(QVariant chatId, QVariant document, QString caption = QString(), int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendDocument(QVariant chatId, QVariant document, QString caption, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendSticker(QVariant chatId, QVariant sticker, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendSticker(QVariant chatId, QVariant sticker, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendVideo(QVariant chatId, QVariant video, QString caption = QString(), int duration = -1, int width = -1, int height = -1, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendVideo(QVariant chatId, QVariant video, QString caption, int duration, int width, int height, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendVoice(QVariant chatId, QVariant voice, QString caption = QString(), int duration = -1, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendVoice(QVariant chatId, QVariant voice, QString caption, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendVideoNote(QVariant chatId, QVariant videoNote, int length = -1, int duration = -1, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendVideoNote(QVariant chatId, QVariant videoNote, int length, int duration, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendLocation(QVariant chatId, double latitude, double longitude, int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendLocation(QVariant chatId, double latitude, double longitude, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendVenue(QVariant chatId, double latitude, double longitude, QString title, QString address, QString foursquareId = QString(), int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendVenue(QVariant chatId, double latitude, double longitude, QString title, QString address, QString foursquareId, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
         void sendContact(QVariant chatId, QString phoneNumber, QString firstName, QString lastName = QString(), int replyToMessageId = 0, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest(), TelegramBotMessage* response = 0);
+        void sendContact(QVariant chatId, QString phoneNumber, QString firstName, QString lastName, int replyToMessageId, TelegramFlags flags, TelegramKeyboardRequest keyboard, QDelegate<void(TelegramBotMessage)> delegate);
+
+        // Broadcast Functions (returns the broadcast id, results are reported by the broadcast signals)
+        int broadcastMessage(QList<QVariant> chatIds, QString text, TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest());
+        int broadcastPhoto(QList<QVariant> chatIds, QVariant photo, QString caption = QString(), TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest());
+        int broadcastDocument(QList<QVariant> chatIds, QVariant document, QString caption = QString(), TelegramFlags flags = TelegramFlags::NoFlag, TelegramKeyboardRequest keyboard = TelegramKeyboardRequest());
+        void cancelBroadcast(int broadcastId);
 
         // Message Puller
         void startMessagePulling(uint timeout = 10, uint limit = 100, TelegramPollMessageTypes messageTypes = TelegramPollMessageTypes::All, long offset = 0);
         void stopMessagePulling(bool instantly = false);
+        void setAdaptivePulling(bool enabled = true, uint maxTimeout = 50);
+        int updateBacklogEstimate();
+        void setOffsetStore(TelegramBotOffsetStore* offsetStore); // stores the last processed update, pulling resumes after it (updates which were received, but not processed before a crash are lost)
+        void setStartupDrain(TelegramDrainPolicy policy, uint maxAge = 60);
+        void setPullWatchdog(uint graceSeconds = 10);
+        int pullStalls();
+        qint64 pullReconnectTime();
+
+        // Update queue functions
+        void setUpdateQueue(int capacity, TelegramOverflowPolicy policy = TelegramOverflowPolicy::BlockPulling, TelegramPollMessageTypes dropTypes = TelegramPollMessageTypes::All);
+        UpdateQueueMetrics updateQueueMetrics(bool reset = false);
+        void setUpdateLaneWeights(int interactive = 4, int normal = 1); // interactive 0 disables the interactive lane
+
+        // Dispatch functions (refused while updates are dispatched)
+        // Note: newMessage is emitted in the dispatch threads, receivers of other threads (e.g. the bot's thread) are called queued and therefore serially,
+        //       so connect them with Qt::DirectConnection (and make them thread safe) to handle the updates in parallel
+        void setDispatchThreads(int threads);
+
+        // Traffic recording functions (raw getUpdates bodies and webhook payloads, e.g. for load tests)
+        bool startTrafficRecording(QString filePath);
+        void stopTrafficRecording();
+        bool replayTraffic(QString filePath, double speed = 1); // speed: 2 = twice as fast as recorded, 0 = as fast as possible
+
+        // Distribution functions (the pulling/webhook process shards the updates by chat to worker processes over local sockets)
+        bool startUpdateDistribution(QString serverName, int workers);
+        void stopUpdateDistribution();
+        void connectToDistributor(QString serverName, int worker);
 
         // Webhook Functions
         bool setHttpServerWebhook(qint16 port, QString pathCert, QString pathPrivateKey, int maxConnections = 10, TelegramPollMessageTypes messageTypes = TelegramPollMessageTypes::All);
+        void setHttpServerWebhook(qint16 port, QString pathCert, QString pathPrivateKey, int maxConnections, TelegramPollMessageTypes messageTypes, QDelegate<void(bool)> delegate);
         void deleteWebhook();
         TelegramBotOperationResult deleteWebhookResult();
+        void deleteWebhookResult(QDelegate<void(TelegramBotOperationResult)> delegate);
         TelegramBotWebHookInfo getWebhookInfo();
+        void getWebhookInfo(QDelegate<void(TelegramBotWebHookInfo)> delegate);
 
         // Message Router functions
         void messageRouterRegister(QString startWith, QDelegate<bool(TelegramBotUpdate)> delegate, TelegramBotMessageType type = TelegramBotMessageType::All);
 
+        // Rate limit functions (0 disables the limit)
+        void setRateLimits(double globalPerSecond = 30, double privateChatPerSecond = 1, double groupChatPerMinute = 20);
+
+        // Retry functions (send and forward calls are only repeated if they surely didn't reach telegram, unless retryNonIdempotent is set)
+        void setRetryPolicy(int maxAttempts = 3, int baseDelay = 500, bool retryNonIdempotent = false);
+        TelegramBotOperationResult lastCallResult(); // ok flag, error and attempt count of the answer which is delivered right now (valid inside any delegate and after a synchronous call)
+
+        // Request priority functions
+        void setRequestPriority(TelegramRequestPriority priority = TelegramRequestPriority::InferPriority); // priority of the following calls of the calling thread (see TelegramBotPriorityScope)
+        void setPriorityConcurrency(TelegramRequestPriority priority, int maxRequests);
+
+        // Api server functions (e.g. a local telegram-bot-api server: setApiServer("http://localhost:8081", true))
+        void setApiServer(QString apiServer = "https://api.telegram.org", bool localMode = false);
+
+        // Trace functions
+        void setTraceRateLimit(int messagesPerSecond = 50);
+
+        // Connection functions
+        void setHttp2Enabled(bool enabled);
+        void setConnectionsPerHost(int connections);
+        void setKeepAliveInterval(uint seconds);
+
     private slots:
         // pull functions
         void pull();
+        void handlePullData();
         void handlePullResponse();
+        void processUpdates();
+        void handlePullStall();
+
+        // traffic replay functions
+        void replayNextFrame();
+
+        // distribution functions
+        void handleDistributionConnection();
+        void readDistributedUpdates();
 
         // parser functions
         void parseMessage(QByteArray &data, bool singleMessage = false);
@@ -152,33 +386,249 @@ class TelegramBot : public QObject
         // webhook functions
         void handleServerWebhookResponse(HttpServerRequest request, HttpServerResponse response);
 
+        // request dispatcher functions
+        void processRequestQueue();
+
+        // connection functions
+        void preconnect();
+        void keepAlive();
+
+#ifdef TELEGRAMBOT_TRACE
+        // trace functions
+        void flushTrace();
+#endif
+
+        // broadcast functions
+        void processBroadcast(int broadcastId);
+        void handleBroadcastResult(int broadcastId, QVariant chatId, QJsonObject object);
+
     private:
         // call Api Helpers
         template<typename T>
-        typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type callApiTemplate(QString method, QUrlQuery params = QUrlQuery(), T* response = 0, QHttpMultiPart* multiPart = 0);
+        typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type callApiTemplate(QString method, TelegramBotParams params, QDelegate<void(T)> delegate, QHttpMultiPart* multiPart = 0);
         template<typename T>
-        typename std::enable_if<!std::is_base_of<TelegramBotObject, T>::value>::type callApiTemplate(QString method, QUrlQuery params = QUrlQuery(), T* response = 0, QHttpMultiPart* multiPart = 0);
-
-        QNetworkReply* callApi(QString method, QUrlQuery params = QUrlQuery(), bool deleteOnFinish = true, QHttpMultiPart* multiPart = 0);
-        QJsonObject callApiJson(QString method, QUrlQuery params = QUrlQuery(), QHttpMultiPart* multiPart = 0);
+        typename std::enable_if<!std::is_base_of<TelegramBotObject, T>::value>::type callApiTemplate(QString method, TelegramBotParams params, QDelegate<void(T)> delegate, QHttpMultiPart* multiPart = 0);
+
+        QNetworkReply* callApi(QString method, TelegramBotParams params = TelegramBotParams(), bool deleteOnFinish = true, QHttpMultiPart* multiPart = 0, TelegramRequestPriority priority = TelegramRequestPriority::Normal, QByteArray formBody = QByteArray());
+        void callApiJson(QString method, TelegramBotParams params, QDelegate<void(QJsonObject)> delegate, QHttpMultiPart* multiPart = 0, TelegramRequestPriority priority = TelegramRequestPriority::InferPriority);
+        void queueRequest(TelegramBotRequest request);
+        void sendRequest(TelegramBotRequest request);
+
+        // broadcast helpers
+        int broadcast(QString method, QList<QVariant> chatIds, TelegramBotParams params, QString fileField = QString(), QVariant file = QVariant());
+
+        // pull helpers
+        void adaptPullParams(int batchSize);
+        void checkpointOffset();
+        void skipToLatestUpdate();
+        void filterStaleUpdates(QJsonArray& updates);
+
+        // update queue helpers
+        bool enqueueUpdates(QJsonArray updates, bool replayed = false);
+        bool updateQueueBlocked();
+        bool updateDroppable(QJsonObject& update);
+        int updateQueueDepth();
+        int updateLane(QJsonObject& update);
+        int pendingUpdateCount();
+        void finishUpdate(qint64 updateId, bool replayed = false);
+
+        // traffic recording helpers
+        void recordTraffic(QByteArray& data, bool singleMessage);
+
+        // dispatch helpers
+        void stopDispatchThreads();
+        qint64 updateDispatchKey(QJsonObject& update);
+        void distributeUpdate(QJsonObject& update);
+        void flushDistributionBacklog(int worker);
+        bool distributionSocketFull(QLocalSocket* socket);
+
+        // parser helpers
+        QJsonArray parseUpdates(QByteArray& data, bool singleMessage = false);
+        void dispatchUpdate(QJsonObject update);
 
         // helpers
         QHttpMultiPart* createUploadFile(QString name, QString fileName, QByteArray& content, bool detectMimeType = false, QHttpMultiPart* multiPart = 0);
-        void hanldeReplyMarkup(QUrlQuery& params, TelegramFlags flags, TelegramKeyboardRequest& keyboard);
-        QHttpMultiPart* handleFile(QString fieldName, QVariant file, QUrlQuery& params, QHttpMultiPart* multiPart = 0);
+        QByteArray createFormBody(TelegramBotParams& params);
+        void appendFormFields(TelegramBotParams& params, QHttpMultiPart* multiPart);
+#ifdef TELEGRAMBOT_TRACE
+        void trace(QString message);
+#endif
+        void hanldeReplyMarkup(TelegramBotParams& params, TelegramFlags flags, TelegramKeyboardRequest& keyboard);
+        QHttpMultiPart* handleFile(QString fieldName, QVariant file, TelegramBotParams& params, QHttpMultiPart* multiPart = 0);
 
         // global data
         QNetworkAccessManager aManager;
+        QNetworkAccessManager pullManager; // getUpdates (long polls)
         QString apiKey;
         long updateId = 0;
 
+        // api server
+        QString apiServer = "https://api.telegram.org";
+        bool localMode = false;
+
+        // connection policy (http/2 follows Qt's default until it's set explicitly)
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        bool http2Enabled = true;
+#else
+        bool http2Enabled = false;
+#endif
+        int connectionsPerHost = 6;
+        QTimer keepAliveTimer;
+        qint64 lastRequestTime = 0;
+
+#ifdef TELEGRAMBOT_TRACE
+        // request tracing (messages are buffered and written at most once a second)
+        QStringList traceMessages;
+        int traceRateLimit = 50;
+        int traceDropped = 0;
+        QTimer traceTimer;
+#endif
+
         // message puller
         QNetworkReply* replyPull = 0;
-        QUrlQuery pullParams;
+        TelegramBotParams pullParams;
+        JsonStreamReader pullReader; // decodes the updates of a batch while it arrives
+        int pullBatchSize = 0;
+        QMap<qint64, bool> unfinishedUpdates; // received, but not yet processed update ids (the first one limits the stored offset)
+        QByteArray pullRecordData;
+        TelegramBotOffsetStore* offsetStore = 0;
+        QTimer offsetCheckpointTimer;
+        qint64 processedUpdateId = 0;
+
+        // message puller (adaptive limit and timeout)
+        bool pullAdaptive = false;
+        uint pullMaxTimeout = 50;
+        uint pullLimit = 100;
+        uint pullLimitMin = 100;
+        uint pullTimeout = 10;
+        uint pullTimeoutMin = 10;
+        bool pullBatchFull = false;
+
+        // message puller (startup drain)
+        TelegramDrainPolicy drainPolicy = TelegramDrainPolicy::NoDrain;
+        uint drainMaxAge = 60;
+        qint64 drainLastDate = 0;
+        bool draining = false;
+
+        // message puller (watchdog for stalled pulls, e.g. silently dropped connections)
+        QTimer pullWatchdog;
+        uint pullWatchdogGrace = 10;
+        int pullStallCount = 0;
+        qint64 pullStalledSince = 0;
+        qint64 pullLastReconnectTime = 0;
+
+        // update queue (between ingestion and dispatch)
+        struct PendingUpdate
+        {
+            QJsonObject update;
+            qint64 queued;
+            bool replayed; // fed by a traffic replay, so it doesn't change the offset
+        };
+        QList<PendingUpdate> pendingUpdates[2]; // lanes: 0 = interactive (callback and inline queries), 1 = normal
+        int updateLaneWeights[2] = { 4, 1 };
+        int updateLanePosition = 0;
+        bool pendingUpdatesScheduled = false;
+        bool pullBlocked = false;
+        int updateQueueCapacity = 0;
+        TelegramOverflowPolicy updateQueuePolicy = TelegramOverflowPolicy::BlockPulling;
+        TelegramPollMessageTypes updateQueueDropTypes = TelegramPollMessageTypes::All;
+        UpdateQueueMetrics updateQueueStats = { 0, 0, 0, 0, 0 };
+
+        // traffic recording and replay (frames: recording time (ms since epoch), webhook flag, raw payload)
+        QFile trafficRecordFile;
+        QDataStream trafficRecordStream;
+        QFile trafficReplayFile;
+        QDataStream trafficReplayStream;
+        QTimer trafficReplayTimer;
+        double trafficReplaySpeed = 1;
+        qint64 trafficReplayFirstFrame = 0;
+        QElapsedTimer trafficReplayElapsed;
+        int trafficReplayUpdates = 0;
+        bool trafficReplayBlocked = false;
+
+        // multi threaded dispatch (every executor lives in it's own thread and processes it's updates serially)
+        struct DispatchQueue
+        {
+            QList<PendingUpdate> updates; // only accessed in the executor's thread
+            bool draining = false;
+        };
+        QList<QThread*> dispatchThreads;
+        QList<QObject*> dispatchExecutors;
+        QList<DispatchQueue*> dispatchQueues;
+        int updatesInDispatch = 0;
+        bool processingUpdates = false;
+
+        // process level distribution (distributor: one socket per worker, updates of unconnected or slow workers are kept until the worker can take them, limited by the update queue capacity)
+        QLocalServer* distributionServer = 0;
+        QVector<QLocalSocket*> distributionWorkers;
+        QVector<QList<PendingUpdate>> distributionBacklog;
+
+        // process level distribution (worker)
+        QLocalSocket* distributorSocket = 0;
+        QString distributorName;
+        int distributorWorker = -1;
+        bool distributorBlocked = false;
 
         // httpserver webhook
         static QMap<qint16, HttpServer*> webHookWebServers;
 
+        // request dispatcher (token bucket rate limiter)
+        struct RateLimit
+        {
+            double capacity;
+            double tokensPerMs;
+        };
+        struct RateBucket
+        {
+            double tokens = 0;
+            qint64 lastRefill = 0;
+            qint64 pausedUntil = 0;
+            bool groupChat = false;
+        };
+        qint64 rateBucketDelay(RateBucket& bucket, const RateLimit& limit, qint64 now);
+        RateLimit rateLimitGlobal      = { 30, 30 / 1000.0 };
+        RateLimit rateLimitPrivateChat = { 1,  1 / 1000.0 };
+        RateLimit rateLimitGroupChat   = { 20, 20 / 60000.0 };
+        RateBucket rateBucketGlobal;
+        QMap<QString, RateBucket> rateBucketsChat;
+        QTimer requestTimer;
+
+        // request dispatcher (retries)
+        int retryMaxAttempts = 3;
+        int retryBaseDelay = 500;
+        bool retryNonIdempotent = false;
+        TelegramBotOperationResult callResult;
+
+        // request dispatcher (priority lanes)
+        QList<TelegramBotRequest> requestQueues[3];
+        int requestsInFlight[3] = { 0, 0, 0 };
+        int requestConcurrency[3] = { 6, 6, 3 };
+
+        // request dispatcher (coalesced read calls: method + params -> waiting delegates)
+        QMap<QString, QList<QDelegate<void(QJsonObject)>>> pendingReads;
+
+        // broadcasts
+        struct Broadcast
+        {
+            QString method;
+            QList<QVariant> chatIds;
+            TelegramBotParams params;
+            QByteArray formBody;
+
+            // file which is uploaded once, all other chats receive the file id
+            QString fileField;
+            QVariant file;
+            QString fileId;
+
+            // progress
+            int next = 0;
+            int inFlight = 0;
+            int sent = 0;
+            int failed = 0;
+        };
+        QMap<int, Broadcast*> broadcasts;
+        int broadcastCounter = 0;
+
         // message router
         struct MessageRoute
         {
@@ -189,6 +639,19 @@ class TelegramBot : public QObject
         QList<MessageRoute*> messageRoutes;
 };
 
+// TelegramBotPriorityScope - api calls of the current thread are sent with the given priority while the scope exists
+// e.g. { TelegramBotPriorityScope bulk(TelegramBot::Bulk); for(qint64 chatId : chatIds) bot.sendMessage(chatId, "News"); }
+class TelegramBotPriorityScope
+{
+    public:
+        TelegramBotPriorityScope(TelegramBot::TelegramRequestPriority priority);
+        ~TelegramBotPriorityScope();
+
+    private:
+        Q_DISABLE_COPY(TelegramBotPriorityScope)
+        TelegramBot::TelegramRequestPriority previous;
+};
+
 /*
  * TelegramPollMessageTypes - operators
  */
@@ -0,0 +1,29 @@
+#include "telegrambotoffsetstore.h"
+
+TelegramBotFileOffsetStore::TelegramBotFileOffsetStore(QString filePath) : filePath(filePath) { }
+
+qint64 TelegramBotFileOffsetStore::load()
+{
+    // a missing file is no error, it just means that nothing was processed yet
+    QFile file(this->filePath);
+    if(!file.open(QFile::ReadOnly)) return 0;
+    this->storedUpdateId = file.readAll().trimmed().toLongLong();
+    return this->storedUpdateId;
+}
+
+void TelegramBotFileOffsetStore::store(qint64 updateId)
+{
+    // skip writes which wouldn't change anything
+    if(updateId == this->storedUpdateId) return;
+
+    // write to a temporary file and replace the old file on commit (QSaveFile syncs the data to disk before)
+    QSaveFile file(this->filePath);
+    if(!file.open(QFile::WriteOnly)) {
+        return (void)qWarning("TelegramBotFileOffsetStore::store - Cannot open file \"%s\" for writing...", qPrintable(this->filePath));
+    }
+    file.write(QByteArray::number(updateId) + "\n");
+    if(!file.commit()) {
+        return (void)qWarning("TelegramBotFileOffsetStore::store - Cannot write file \"%s\"...", qPrintable(this->filePath));
+    }
+    this->storedUpdateId = updateId;
+}
@@ -0,0 +1,30 @@
+#ifndef TELEGRAMBOTOFFSETSTORE_H
+#define TELEGRAMBOTOFFSETSTORE_H
+
+#include <QString>
+#include <QSaveFile>
+#include <QFile>
+
+// TelegramBotOffsetStore - persists the id of the last processed update, so that message pulling can resume after a restart
+// Note: store() is called once per pull (at most once per second without pulling), so implementations can afford one durable write per call
+struct TelegramBotOffsetStore
+{
+    virtual qint64 load() = 0;
+    virtual void store(qint64 updateId) = 0;
+    virtual ~TelegramBotOffsetStore() {}
+};
+
+// TelegramBotFileOffsetStore - default implementation, keeps the update id in a file which is replaced atomically (and synced to disk)
+class TelegramBotFileOffsetStore : public TelegramBotOffsetStore
+{
+    public:
+        TelegramBotFileOffsetStore(QString filePath);
+        qint64 load() override;
+        void store(qint64 updateId) override;
+
+    private:
+        QString filePath;
+        qint64 storedUpdateId = 0;
+};
+
+#endif // TELEGRAMBOTOFFSETSTORE_H
@@ -1,6 +1,12 @@
 #ifndef TELEGRAMDATAINTERFACE_H
 #define TELEGRAMDATAINTERFACE_H
 
+#include <QAtomicPointer>
+#include <QHash>
+#include <QVector>
+#include <initializer_list>
+#include <functional>
+
 #include "jsonhelper.h"
 
 struct TelegramBotObject
@@ -9,13 +15,68 @@ struct TelegramBotObject
     virtual ~TelegramBotObject() {}
 };
 
+// TelegramBotLazyObject - pointer like member, which keeps the raw json object and parses it on first access (the result is cached)
+// Note: the first access may happen in several threads at once, in this case the result of the losing thread is dropped
+template<typename T>
+class TelegramBotLazyObject
+{
+    public:
+        TelegramBotLazyObject() { }
+        ~TelegramBotLazyObject() { delete this->pointer.loadAcquire(); }
+
+        void setJson(QJsonObject object)
+        {
+            delete this->pointer.fetchAndStoreOrdered(0);
+            this->object = object;
+            this->available = true;
+            this->resolve = nullptr;
+        }
+
+        // the object is a member of the object of another lazy object (e.g. the message of a callback query), so it resolves to that member instead of an own copy
+        template<typename P>
+        void setJson(QJsonObject object, const TelegramBotLazyObject<P>& parent, T P::* member)
+        {
+            this->setJson(object);
+            this->resolve = [&parent, member]() { return &(parent.get()->*member); };
+        }
+        const QJsonObject& json() const { return this->object; }
+
+        T* get() const
+        {
+            if(this->resolve) return this->available ? this->resolve() : 0;
+            T* result = this->pointer.loadAcquire();
+            if(result || !this->available) return result;
+            result = new T;
+            QJsonObject object = this->object;
+            result->fromJson(object);
+            if(!this->pointer.testAndSetOrdered(0, result)) {
+                delete result;
+                result = this->pointer.loadAcquire();
+            }
+            return result;
+        }
+
+        // checking for existence doesn't parse anything
+        explicit operator bool() const { return this->available; }
+        operator T*() const { return this->get(); }
+        T* operator->() const { return this->get(); }
+        T& operator*() const { return *this->get(); }
+
+    private:
+        Q_DISABLE_COPY(TelegramBotLazyObject)
+        QJsonObject object;
+        bool available = false;
+        mutable QAtomicPointer<T> pointer;
+        std::function<T*()> resolve;
+};
+
 template<typename T>
 class JsonHelperT<T, typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type >
 {
     public:
         static bool jsonPathGet(QJsonValue data, QString path, T& target, bool showWarnings = true)
         {
-            QJsonObject object = showWarnings ? JsonHelper::jsonPathGet(data, path).toJsonObject() : JsonHelper::jsonPathGetSilent(data, path).toJsonObject();
+            QJsonObject object = JsonHelper::jsonPathValue(data, path, showWarnings).toObject();
             if(object.isEmpty()) return false;
             target.fromJson(object);
             return true;
@@ -23,7 +84,7 @@ class JsonHelperT<T, typename std::enable_if<std::is_base_of<TelegramBotObject,
 
         static bool jsonPathGetArray(QJsonValue data, QString path, QList<T>& target, bool showWarnings = true)
         {
-            QJsonArray array = showWarnings ? JsonHelper::jsonPathGet(data, path).toJsonArray() : JsonHelper::jsonPathGetSilent(data, path).toJsonArray();
+            QJsonArray array = JsonHelper::jsonPathValue(data, path, showWarnings).toArray();
             if(array.isEmpty()) return false;
 
             for(auto itr = array.begin(); itr != array.end(); itr++) {
@@ -34,7 +95,7 @@ class JsonHelperT<T, typename std::enable_if<std::is_base_of<TelegramBotObject,
 
         static inline bool jsonPathGetArrayArray(QJsonValue data, QString path, QList<QList<T>>& target, bool showWarnings = true)
         {
-            QJsonArray array = showWarnings ? JsonHelper::jsonPathGet(data, path).toJsonArray() : JsonHelper::jsonPathGetSilent(data, path).toJsonArray();
+            QJsonArray array = JsonHelper::jsonPathValue(data, path, showWarnings).toArray();
             if(array.isEmpty()) return false;
 
             for(auto itr = array.begin(); itr != array.end(); itr++) {
@@ -45,4 +106,88 @@ class JsonHelperT<T, typename std::enable_if<std::is_base_of<TelegramBotObject,
 };
 
 
+// TelegramBotFieldValue - parses one field of a data struct (plain values, data structs, lists and lists of lists)
+template<typename T, class Enable = void>
+struct TelegramBotFieldValue
+{
+    static const bool plain = true;
+    static void parse(T& target, const QJsonValue& value) { JsonHelper::jsonValueGet(value, target); }
+};
+
+template<typename T>
+struct TelegramBotFieldValue<T, typename std::enable_if<std::is_base_of<TelegramBotObject, T>::value>::type>
+{
+    static const bool plain = false;
+    static void parse(T& target, const QJsonValue& value) { JsonHelperT<T>::jsonPathGet(value, QString(), target, false); }
+};
+
+template<typename T>
+struct TelegramBotFieldValue<QList<T>>
+{
+    static const bool plain = false;
+    static void parse(QList<T>& target, const QJsonValue& value) { JsonHelperT<T>::jsonPathGetArray(value, QString(), target, false); }
+};
+
+template<typename T>
+struct TelegramBotFieldValue<QList<QList<T>>>
+{
+    static const bool plain = false;
+    static void parse(QList<QList<T>>& target, const QJsonValue& value) { JsonHelperT<T>::jsonPathGetArrayArray(value, QString(), target, false); }
+};
+
+// TelegramBotFieldTable - field descriptors of a data struct, which parse a json object in one pass over it's keys
+// Note: declared plain values which are missing in the json object are reset to their default (objects and lists are left untouched)
+template<typename T>
+class TelegramBotFieldTable
+{
+    public:
+        struct Field
+        {
+            QString key;
+            void (*parse)(T& target, const QJsonValue& value);
+            void (*reset)(T& target); // 0 for objects and lists
+            bool required;
+        };
+
+        TelegramBotFieldTable(std::initializer_list<Field> fields)
+        {
+            for(const Field& field : fields) {
+                this->fields.insert(field.key, field);
+                if(field.reset) this->resets.append(field.reset);
+                if(field.required) this->requiredKeys.append(field.key);
+            }
+        }
+
+        void parse(T& target, QJsonObject& object) const
+        {
+            // dispatch every present key to it's field, so unknown keys and missing optional fields cost nothing
+            for(auto reset : this->resets) reset(target);
+            int required = 0;
+            for(auto itr = object.constBegin(); itr != object.constEnd(); itr++) {
+                auto field = this->fields.constFind(itr.key());
+                if(field == this->fields.constEnd()) continue;
+                field->parse(target, itr.value());
+                required += field->required;
+            }
+
+            // only if a required field is missing, search it for the warning
+            if(required == this->requiredKeys.length()) return;
+            for(const QString& key : this->requiredKeys) {
+                if(!object.contains(key)) qWarning("JsonHelper::jsonPath: pos: %s -> QJsonObject path element not found", qPrintable(key));
+            }
+        }
+
+    private:
+        QHash<QString, Field> fields;
+        QVector<void(*)(T&)> resets;
+        QStringList requiredKeys;
+};
+
+// TELEGRAMBOT_FIELD - field descriptor of a TelegramBotFieldTable (json key, member, required)
+#define TELEGRAMBOT_FIELD(Struct, key, member, required) \
+    { key, \
+      [](Struct& target, const QJsonValue& value) { TelegramBotFieldValue<decltype(Struct::member)>::parse(target.member, value); }, \
+      TelegramBotFieldValue<decltype(Struct::member)>::plain ? static_cast<void(*)(Struct&)>([](Struct& target) { target.member = decltype(Struct::member)(); }) : static_cast<void(*)(Struct&)>(0), \
+      required }
+
 #endif // TELEGRAMDATAINTERFACE_H
@@ -64,14 +64,20 @@ struct TelegramBotOperationResult : public TelegramBotObject {
     bool result;
     qint32 errorCode = 0;
     QString description;
+    qint32 attempts = 1; // Number of attempts needed by the library (not part of the Telegram api)
 
+    TelegramBotOperationResult() { }
     TelegramBotOperationResult(QJsonObject object) { this->fromJson(object); }
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<bool>::jsonPathGet(object, "result", this->result);
-        JsonHelperT<qint32>::jsonPathGet(object, "error_code", this->errorCode, false);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description);
+        static const TelegramBotFieldTable<TelegramBotOperationResult> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotOperationResult, "result", result, true),
+            TELEGRAMBOT_FIELD(TelegramBotOperationResult, "error_code", errorCode, false),
+            TELEGRAMBOT_FIELD(TelegramBotOperationResult, "description", description, true),
+            TELEGRAMBOT_FIELD(TelegramBotOperationResult, "attempts", attempts, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -85,17 +91,21 @@ struct TelegramBotWebHookInfo : public TelegramBotObject {
     qint32 maxConnections;
     QList<QString> allowedUpdates;
 
+    TelegramBotWebHookInfo() { }
     TelegramBotWebHookInfo(QJsonObject object) { this->fromJson(object); }
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "url", this->url);
-        JsonHelperT<bool>::jsonPathGet(object, "has_custom_certificate", this->hasCustomCertificate);
-        JsonHelperT<bool>::jsonPathGet(object, "pending_update_count", this->pendingUpdateCount);
-        JsonHelperT<qint32>::jsonPathGet(object, "last_error_date", this->lastErrorDate, false);
-        JsonHelperT<QString>::jsonPathGet(object, "last_error_message", this->lastErrorMessage, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "max_connections", this->maxConnections, false);
-        JsonHelperT<QString>::jsonPathGetArray(object, "allowed_updates", this->allowedUpdates, false);
+        static const TelegramBotFieldTable<TelegramBotWebHookInfo> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "url", url, true),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "has_custom_certificate", hasCustomCertificate, true),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "pending_update_count", pendingUpdateCount, true),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "last_error_date", lastErrorDate, false),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "last_error_message", lastErrorMessage, false),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "max_connections", maxConnections, false),
+            TELEGRAMBOT_FIELD(TelegramBotWebHookInfo, "allowed_updates", allowedUpdates, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -116,11 +126,14 @@ struct TelegramBotUser : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<qint32>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "first_name", this->firstName);
-        JsonHelperT<QString>::jsonPathGet(object, "last_name", this->lastName, false);
-        JsonHelperT<QString>::jsonPathGet(object, "username", this->username, false);
-        JsonHelperT<QString>::jsonPathGet(object, "language_code", this->languageCode, false);
+        static const TelegramBotFieldTable<TelegramBotUser> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotUser, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotUser, "first_name", firstName, true),
+            TELEGRAMBOT_FIELD(TelegramBotUser, "last_name", lastName, false),
+            TELEGRAMBOT_FIELD(TelegramBotUser, "username", username, false),
+            TELEGRAMBOT_FIELD(TelegramBotUser, "language_code", languageCode, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -134,11 +147,14 @@ struct TelegramBotMessageEntity : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<qint32>::jsonPathGet(object, "offset", this->offset);
-        JsonHelperT<qint32>::jsonPathGet(object, "length", this->length);
-        JsonHelperT<QString>::jsonPathGet(object, "url", this->url, false);
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "user", this->user, false);
+        static const TelegramBotFieldTable<TelegramBotMessageEntity> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotMessageEntity, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotMessageEntity, "offset", offset, true),
+            TELEGRAMBOT_FIELD(TelegramBotMessageEntity, "length", length, true),
+            TELEGRAMBOT_FIELD(TelegramBotMessageEntity, "url", url, false),
+            TELEGRAMBOT_FIELD(TelegramBotMessageEntity, "user", user, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -151,10 +167,13 @@ struct TelegramBotPhotoSize : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "width", this->width);
-        JsonHelperT<qint32>::jsonPathGet(object, "height", this->height);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotPhotoSize> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotPhotoSize, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotPhotoSize, "width", width, true),
+            TELEGRAMBOT_FIELD(TelegramBotPhotoSize, "height", height, true),
+            TELEGRAMBOT_FIELD(TelegramBotPhotoSize, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -167,11 +186,14 @@ struct TelegramBotAnimation : public TelegramBotObject {
     qint32 fileSize; // Optional. File size
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGet(object, "thumb", this->thumb, false);
-        JsonHelperT<QString>::jsonPathGet(object, "file_name", this->fileName, false);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotAnimation> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotAnimation, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotAnimation, "thumb", thumb, false),
+            TELEGRAMBOT_FIELD(TelegramBotAnimation, "file_name", fileName, false),
+            TELEGRAMBOT_FIELD(TelegramBotAnimation, "mime_type", mimeType, false),
+            TELEGRAMBOT_FIELD(TelegramBotAnimation, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -185,12 +207,15 @@ struct TelegramBotGame : public TelegramBotObject {
     TelegramBotAnimation animation; // Optional. Animation that will be displayed in the game message in chats. Upload via BotFather
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGetArray(object, "photo", this->photo);
-        JsonHelperT<QString>::jsonPathGet(object, "text", this->text, false);
-        JsonHelperT<TelegramBotMessageEntity>::jsonPathGetArray(object, "text_entities", this->textEntities, false);
-        JsonHelperT<TelegramBotAnimation>::jsonPathGet(object, "animation", this->animation, false);
+        static const TelegramBotFieldTable<TelegramBotGame> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotGame, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotGame, "description", description, true),
+            TELEGRAMBOT_FIELD(TelegramBotGame, "photo", photo, true),
+            TELEGRAMBOT_FIELD(TelegramBotGame, "text", text, false),
+            TELEGRAMBOT_FIELD(TelegramBotGame, "text_entities", textEntities, false),
+            TELEGRAMBOT_FIELD(TelegramBotGame, "animation", animation, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -201,9 +226,12 @@ struct TelegramBotGameHighScore : public TelegramBotObject {
     qint32 score; // Score
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<qint32>::jsonPathGet(object, "position", this->position);
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "user", this->user);
-        JsonHelperT<qint32>::jsonPathGet(object, "score", this->score);
+        static const TelegramBotFieldTable<TelegramBotGameHighScore> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotGameHighScore, "position", position, true),
+            TELEGRAMBOT_FIELD(TelegramBotGameHighScore, "user", user, true),
+            TELEGRAMBOT_FIELD(TelegramBotGameHighScore, "score", score, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -220,14 +248,17 @@ struct TelegramBotKeyboardButton : public TelegramBotObject
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "text", this->text);
-        JsonHelperT<QString>::jsonPathGet(object, "url", this->url, false);
-        JsonHelperT<QString>::jsonPathGet(object, "callback_data", this->callbackData, false);
-        JsonHelperT<QString>::jsonPathGet(object, "switch_inline_query", this->switchInlineQuery, false);
-        JsonHelperT<QString>::jsonPathGet(object, "switch_inline_query_current_chat", this->switchInlineQueryCurrentChat, false);
-        JsonHelperT<TelegramBotGame>::jsonPathGet(object, "callback_game", this->callbackGame, false);
-        JsonHelperT<bool>::jsonPathGet(object, "request_contact", this->requestContact, false);
-        JsonHelperT<bool>::jsonPathGet(object, "request_location", this->requestLocation, false);
+        static const TelegramBotFieldTable<TelegramBotKeyboardButton> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "text", text, true),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "url", url, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "callback_data", callbackData, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "switch_inline_query", switchInlineQuery, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "switch_inline_query_current_chat", switchInlineQueryCurrentChat, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "callback_game", callbackGame, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "request_contact", requestContact, false),
+            TELEGRAMBOT_FIELD(TelegramBotKeyboardButton, "request_location", requestLocation, false)
+        };
+        fields.parse(*this, object);
     }
 };
 typedef QList<QList<TelegramBotKeyboardButton>> TelegramKeyboard;
@@ -247,13 +278,16 @@ struct TelegramBotChat : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<qint32>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "username", this->username, false);
-        JsonHelperT<QString>::jsonPathGet(object, "first_name", this->firstName, false);
-        JsonHelperT<QString>::jsonPathGet(object, "last_name", this->lastName, false);
-        JsonHelperT<bool>::jsonPathGet(object, "all_members_are_administrators", this->allMembersAreAdministrators, false);
+        static const TelegramBotFieldTable<TelegramBotChat> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotChat, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "username", username, false),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "first_name", firstName, false),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "last_name", lastName, false),
+            TELEGRAMBOT_FIELD(TelegramBotChat, "all_members_are_administrators", allMembersAreAdministrators, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -268,12 +302,15 @@ struct TelegramBotAudio : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "duration", this->duration);
-        JsonHelperT<QString>::jsonPathGet(object, "performer", this->performer, false);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotAudio> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "duration", duration, true),
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "performer", performer, false),
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "mime_type", mimeType, false),
+            TELEGRAMBOT_FIELD(TelegramBotAudio, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -287,11 +324,14 @@ struct TelegramBotDocument : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGet(object, "thumb", this->thumb, false);
-        JsonHelperT<QString>::jsonPathGet(object, "file_name", this->fileName, false);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotDocument> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotDocument, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotDocument, "thumb", thumb, false),
+            TELEGRAMBOT_FIELD(TelegramBotDocument, "file_name", fileName, false),
+            TELEGRAMBOT_FIELD(TelegramBotDocument, "mime_type", mimeType, false),
+            TELEGRAMBOT_FIELD(TelegramBotDocument, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -306,12 +346,15 @@ struct TelegramBotSticker : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "width", this->width);
-        JsonHelperT<qint32>::jsonPathGet(object, "height", this->height);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGet(object, "thumb", this->thumb, false);
-        JsonHelperT<QString>::jsonPathGet(object, "emoji", this->emoji, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotSticker> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "width", width, true),
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "height", height, true),
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "thumb", thumb, false),
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "emoji", emoji, false),
+            TELEGRAMBOT_FIELD(TelegramBotSticker, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -327,13 +370,16 @@ struct TelegramBotVideo : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "width", this->width);
-        JsonHelperT<qint32>::jsonPathGet(object, "height", this->height);
-        JsonHelperT<qint32>::jsonPathGet(object, "duration", this->duration);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGet(object, "thumb", this->thumb, false);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotVideo> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "width", width, true),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "height", height, true),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "duration", duration, true),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "thumb", thumb, false),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "mime_type", mimeType, false),
+            TELEGRAMBOT_FIELD(TelegramBotVideo, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -346,10 +392,13 @@ struct TelegramBotVoice : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "duration", this->duration);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
+        static const TelegramBotFieldTable<TelegramBotVoice> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotVoice, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotVoice, "duration", duration, true),
+            TELEGRAMBOT_FIELD(TelegramBotVoice, "mime_type", mimeType, false),
+            TELEGRAMBOT_FIELD(TelegramBotVoice, "file_size", fileSize, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -362,10 +411,13 @@ struct TelegramBotContact : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "phone_number", this->phoneNumber);
-        JsonHelperT<QString>::jsonPathGet(object, "first_name", this->firstName);
-        JsonHelperT<QString>::jsonPathGet(object, "last_name", this->lastName, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "user_id", this->userId, false);
+        static const TelegramBotFieldTable<TelegramBotContact> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotContact, "phone_number", phoneNumber, true),
+            TELEGRAMBOT_FIELD(TelegramBotContact, "first_name", firstName, true),
+            TELEGRAMBOT_FIELD(TelegramBotContact, "last_name", lastName, false),
+            TELEGRAMBOT_FIELD(TelegramBotContact, "user_id", userId, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -376,8 +428,11 @@ struct TelegramBotLocation : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<double>::jsonPathGet(object, "longitude", this->longitude);
-        JsonHelperT<double>::jsonPathGet(object, "latitude", this->latitude);
+        static const TelegramBotFieldTable<TelegramBotLocation> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotLocation, "longitude", longitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotLocation, "latitude", latitude, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -390,10 +445,13 @@ struct TelegramBotVenue : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<TelegramBotLocation>::jsonPathGet(object, "location", this->location);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "address", this->address);
-        JsonHelperT<QString>::jsonPathGet(object, "foursquare_id", this->foursquareId, false);
+        static const TelegramBotFieldTable<TelegramBotVenue> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotVenue, "location", location, true),
+            TELEGRAMBOT_FIELD(TelegramBotVenue, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotVenue, "address", address, true),
+            TELEGRAMBOT_FIELD(TelegramBotVenue, "foursquare_id", foursquareId, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -402,12 +460,16 @@ struct TelegramBotUserProfilePhotos : public TelegramBotObject {
     qint32 totalCount; // Total number of profile pictures the target user has
     QList<QList<TelegramBotPhotoSize>> photos; // Requested profile pictures (in up to 4 sizes each)
 
+    TelegramBotUserProfilePhotos() { }
     TelegramBotUserProfilePhotos(QJsonObject object) { this->fromJson(object); }
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<qint32>::jsonPathGet(object, "total_count", this->totalCount);
-        JsonHelperT<TelegramBotPhotoSize>::jsonPathGetArrayArray(object, "photos", this->photos);
+        static const TelegramBotFieldTable<TelegramBotUserProfilePhotos> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotUserProfilePhotos, "total_count", totalCount, true),
+            TELEGRAMBOT_FIELD(TelegramBotUserProfilePhotos, "photos", photos, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -419,13 +481,17 @@ struct TelegramBotFile : public TelegramBotObject {
     QString link; // Generated Absolute link to picture
     QDateTime validUntil; // Genetated valid time
 
+    TelegramBotFile() { }
     TelegramBotFile(QJsonObject object) { this->fromJson(object); }
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "file_id", this->fileId);
-        JsonHelperT<qint32>::jsonPathGet(object, "file_size", this->fileSize, false);
-        JsonHelperT<QString>::jsonPathGet(object, "file_path", this->filePath, false);
+        static const TelegramBotFieldTable<TelegramBotFile> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotFile, "file_id", fileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotFile, "file_size", fileSize, false),
+            TELEGRAMBOT_FIELD(TelegramBotFile, "file_path", filePath, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -439,20 +505,26 @@ struct TelegramBotChatMember : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "user", this->user);
-        JsonHelperT<QString>::jsonPathGet(object, "status", this->status);
+        static const TelegramBotFieldTable<TelegramBotChatMember> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotChatMember, "user", user, true),
+            TELEGRAMBOT_FIELD(TelegramBotChatMember, "status", status, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
 // TelegramBotResponseParameters - Contains information about why a request was unsuccessfull.
 struct TelegramBotResponseParameters : public TelegramBotObject {
-    qint32 migrateToChatId; // Optional. The group has been migrated to a supergroup with the specified identifier. This number may be greater than 32 bits and some programming languages may have difficulty/silent defects in interpreting it. But it is smaller than 52 bits, so a signed 64 bit integer or double-precision float type are safe for storing this identifier.
-    qint32 retryAfter; // Optional. In case of exceeding flood control, the number of seconds left to wait before the request can be repeated
+    qint32 migrateToChatId = 0; // Optional. The group has been migrated to a supergroup with the specified identifier. This number may be greater than 32 bits and some programming languages may have difficulty/silent defects in interpreting it. But it is smaller than 52 bits, so a signed 64 bit integer or double-precision float type are safe for storing this identifier.
+    qint32 retryAfter = 0; // Optional. In case of exceeding flood control, the number of seconds left to wait before the request can be repeated
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<qint32>::jsonPathGet(object, "migrate_to_chat_id", this->migrateToChatId, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "retry_after", this->retryAfter, false);
+        static const TelegramBotFieldTable<TelegramBotResponseParameters> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotResponseParameters, "migrate_to_chat_id", migrateToChatId, false),
+            TELEGRAMBOT_FIELD(TelegramBotResponseParameters, "retry_after", retryAfter, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -490,39 +562,39 @@ struct TelegramBotResponseParameters : public TelegramBotObject {
     qint32 migrateToChatId; /* Optional. The group has been migrated to a supergroup with the specified identifier. This number may be greater than 32 bits and some programming languages may have difficulty/silent defects in interpreting it. But it is smaller than 52 bits, so a signed 64 bit integer or double-precision float type are safe for storing this identifier. */\
     qint32 migrateFromChatId; /* Optional. The supergroup has been migrated from a group with the specified identifier. This number may be greater than 32 bits and some programming languages may have difficulty/silent defects in interpreting it. But it is smaller than 52 bits, so a signed 64 bit integer or double-precision float type are safe for storing this identifier. */\
 
-#define TELEGRAMBOTMESSAGE_FIELD_PARSING \
-    JsonHelperT<qint32>::jsonPathGet(object, "message_id", this->messageId); \
-    JsonHelperT<TelegramBotUser>::jsonPathGet(object, "from", this->from, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "date", this->date); \
-    JsonHelperT<TelegramBotChat>::jsonPathGet(object, "chat", this->chat, false); \
-    JsonHelperT<TelegramBotUser>::jsonPathGet(object, "forward_from", this->forwardFrom, false); \
-    JsonHelperT<TelegramBotChat>::jsonPathGet(object, "forward_from_chat", this->forwardFromChat, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "forward_from_message_id", this->forwardFromMessageId, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "forward_date", this->forwardDate, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "edit_date", this->editDate, false); \
-    JsonHelperT<QString>::jsonPathGet(object, "text", this->text, false); \
-    JsonHelperT<TelegramBotMessageEntity>::jsonPathGetArray(object, "entities", this->entities, false); \
-    JsonHelperT<TelegramBotAudio>::jsonPathGet(object, "audio", this->audio, false); \
-    JsonHelperT<TelegramBotDocument>::jsonPathGet(object, "document", this->document, false); \
-    JsonHelperT<TelegramBotGame>::jsonPathGet(object, "game", this->game, false); \
-    JsonHelperT<TelegramBotPhotoSize>::jsonPathGetArray(object, "photo", this->photo, false); \
-    JsonHelperT<TelegramBotSticker>::jsonPathGet(object, "sticker", this->sticker, false); \
-    JsonHelperT<TelegramBotVideo>::jsonPathGet(object, "video", this->video, false); \
-    JsonHelperT<TelegramBotVoice>::jsonPathGet(object, "voice", this->voice, false); \
-    JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false); \
-    JsonHelperT<TelegramBotContact>::jsonPathGet(object, "contact", this->contact, false); \
-    JsonHelperT<TelegramBotLocation>::jsonPathGet(object, "location", this->location, false); \
-    JsonHelperT<TelegramBotVenue>::jsonPathGet(object, "venue", this->venue, false); \
-    JsonHelperT<TelegramBotUser>::jsonPathGet(object, "new_chat_member", this->newChatMember, false); \
-    JsonHelperT<TelegramBotUser>::jsonPathGet(object, "left_chat_member", this->leftChatMember, false); \
-    JsonHelperT<QString>::jsonPathGet(object, "new_chat_title", this->newChatTitle, false); \
-    JsonHelperT<TelegramBotPhotoSize>::jsonPathGetArray(object, "new_chat_photo", this->newChatPhoto, false); \
-    JsonHelperT<bool>::jsonPathGet(object, "delete_chat_photo = false", this->deleteChatPhoto, false); \
-    JsonHelperT<bool>::jsonPathGet(object, "group_chat_created = false", this->groupChatCreated, false); \
-    JsonHelperT<bool>::jsonPathGet(object, "supergroup_chat_created = false", this->supergroupChatCreated, false); \
-    JsonHelperT<bool>::jsonPathGet(object, "channel_chat_created = false", this->channelChatCreated, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "migrate_to_chat_id", this->migrateToChatId, false); \
-    JsonHelperT<qint32>::jsonPathGet(object, "migrate_from_chat_id", this->migrateFromChatId, false);
+#define TELEGRAMBOTMESSAGE_FIELD_TABLE(Struct) \
+    TELEGRAMBOT_FIELD(Struct, "message_id", messageId, true), \
+    TELEGRAMBOT_FIELD(Struct, "from", from, false), \
+    TELEGRAMBOT_FIELD(Struct, "date", date, true), \
+    TELEGRAMBOT_FIELD(Struct, "chat", chat, false), \
+    TELEGRAMBOT_FIELD(Struct, "forward_from", forwardFrom, false), \
+    TELEGRAMBOT_FIELD(Struct, "forward_from_chat", forwardFromChat, false), \
+    TELEGRAMBOT_FIELD(Struct, "forward_from_message_id", forwardFromMessageId, false), \
+    TELEGRAMBOT_FIELD(Struct, "forward_date", forwardDate, false), \
+    TELEGRAMBOT_FIELD(Struct, "edit_date", editDate, false), \
+    TELEGRAMBOT_FIELD(Struct, "text", text, false), \
+    TELEGRAMBOT_FIELD(Struct, "entities", entities, false), \
+    TELEGRAMBOT_FIELD(Struct, "audio", audio, false), \
+    TELEGRAMBOT_FIELD(Struct, "document", document, false), \
+    TELEGRAMBOT_FIELD(Struct, "game", game, false), \
+    TELEGRAMBOT_FIELD(Struct, "photo", photo, false), \
+    TELEGRAMBOT_FIELD(Struct, "sticker", sticker, false), \
+    TELEGRAMBOT_FIELD(Struct, "video", video, false), \
+    TELEGRAMBOT_FIELD(Struct, "voice", voice, false), \
+    TELEGRAMBOT_FIELD(Struct, "caption", caption, false), \
+    TELEGRAMBOT_FIELD(Struct, "contact", contact, false), \
+    TELEGRAMBOT_FIELD(Struct, "location", location, false), \
+    TELEGRAMBOT_FIELD(Struct, "venue", venue, false), \
+    TELEGRAMBOT_FIELD(Struct, "new_chat_member", newChatMember, false), \
+    TELEGRAMBOT_FIELD(Struct, "left_chat_member", leftChatMember, false), \
+    TELEGRAMBOT_FIELD(Struct, "new_chat_title", newChatTitle, false), \
+    TELEGRAMBOT_FIELD(Struct, "new_chat_photo", newChatPhoto, false), \
+    TELEGRAMBOT_FIELD(Struct, "delete_chat_photo", deleteChatPhoto, false), \
+    TELEGRAMBOT_FIELD(Struct, "group_chat_created", groupChatCreated, false), \
+    TELEGRAMBOT_FIELD(Struct, "supergroup_chat_created", supergroupChatCreated, false), \
+    TELEGRAMBOT_FIELD(Struct, "channel_chat_created", channelChatCreated, false), \
+    TELEGRAMBOT_FIELD(Struct, "migrate_to_chat_id", migrateToChatId, false), \
+    TELEGRAMBOT_FIELD(Struct, "migrate_from_chat_id", migrateFromChatId, false)
 
 // TelegramBotMessageSingle - This object represents a message (without any recursive fields which references to same class, see TelegramBotMessage for complete message)
 struct TelegramBotMessageSingle : public TelegramBotObject {
@@ -530,7 +602,10 @@ struct TelegramBotMessageSingle : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        TELEGRAMBOTMESSAGE_FIELD_PARSING
+        static const TelegramBotFieldTable<TelegramBotMessageSingle> fields = {
+            TELEGRAMBOTMESSAGE_FIELD_TABLE(TelegramBotMessageSingle)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -542,12 +617,15 @@ struct TelegramBotMessage : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        // message
-        TELEGRAMBOTMESSAGE_FIELD_PARSING
-
-        // own data
-        JsonHelperT<TelegramBotMessageSingle>::jsonPathGet(object, "reply_to_message", this->replyToMessage, false);
-        JsonHelperT<TelegramBotMessageSingle>::jsonPathGet(object, "pinned_message", this->pinnedMessage, false);
+        static const TelegramBotFieldTable<TelegramBotMessage> fields = {
+            // message
+            TELEGRAMBOTMESSAGE_FIELD_TABLE(TelegramBotMessage),
+
+            // own data
+            TELEGRAMBOT_FIELD(TelegramBotMessage, "reply_to_message", replyToMessage, false),
+            TELEGRAMBOT_FIELD(TelegramBotMessage, "pinned_message", pinnedMessage, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -563,13 +641,16 @@ struct TelegramBotCallbackQuery : public TelegramBotObject {
 
     // parse logic
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "from", this->from);
-        JsonHelperT<TelegramBotMessage>::jsonPathGet(object, "message", this->message, false);
-        JsonHelperT<QString>::jsonPathGet(object, "inline_message_id", this->inlineMessageId, false);
-        JsonHelperT<QString>::jsonPathGet(object, "chat_instance", this->chatInstance);
-        JsonHelperT<QString>::jsonPathGet(object, "data", this->data, false);
-        JsonHelperT<QString>::jsonPathGet(object, "game_short_name", this->gameShortName, false);
+        static const TelegramBotFieldTable<TelegramBotCallbackQuery> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "from", from, true),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "message", message, false),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "inline_message_id", inlineMessageId, false),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "chat_instance", chatInstance, true),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "data", data, false),
+            TELEGRAMBOT_FIELD(TelegramBotCallbackQuery, "game_short_name", gameShortName, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -586,11 +667,14 @@ struct TelegramBotInlineQuery : public TelegramBotObject {
     QString offset; // Offset of the results to be returned, can be controlled by the bot
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "from", this->from);
-        JsonHelperT<TelegramBotLocation>::jsonPathGet(object, "location", this->location, false);
-        JsonHelperT<QString>::jsonPathGet(object, "query", this->query);
-        JsonHelperT<QString>::jsonPathGet(object, "offset", this->offset);
+        static const TelegramBotFieldTable<TelegramBotInlineQuery> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQuery, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQuery, "from", from, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQuery, "location", location, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQuery, "query", query, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQuery, "offset", offset, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -601,9 +685,12 @@ struct TelegramBotInputMessageContent : public TelegramBotObject {
     bool disableWebPagePreview; // Optional. Disables link previews for links in the sent message
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "message_text", this->messageText);
-        JsonHelperT<QString>::jsonPathGet(object, "parse_mode", this->parseMode, false);
-        JsonHelperT<bool>::jsonPathGet(object, "disable_web_page_preview", this->disableWebPagePreview, false);
+        static const TelegramBotFieldTable<TelegramBotInputMessageContent> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInputMessageContent, "message_text", messageText, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputMessageContent, "parse_mode", parseMode, false),
+            TELEGRAMBOT_FIELD(TelegramBotInputMessageContent, "disable_web_page_preview", disableWebPagePreview, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -623,17 +710,20 @@ struct TelegramBotInlineQueryResult : public TelegramBotObject {
     qint32 thumbHeight; // Optional. Thumbnail height
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<QString>::jsonPathGet(object, "url", this->url, false);
-        JsonHelperT<bool>::jsonPathGet(object, "hide_url", this->hideUrl, false);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_width", this->thumbWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_height", this->thumbHeight, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResult> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "input_message_content", inputMessageContent, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "url", url, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "hide_url", hideUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "thumb_url", thumbUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "thumb_width", thumbWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResult, "thumb_height", thumbHeight, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -652,17 +742,20 @@ struct TelegramBotInlineQueryResultPhoto : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the photo
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "photo_url", this->photoUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl);
-        JsonHelperT<qint32>::jsonPathGet(object, "photo_width", this->photoWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "photo_height", this->photoHeight, false);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultPhoto> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "photo_url", photoUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "thumb_url", thumbUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "photo_width", photoWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "photo_height", photoHeight, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultPhoto, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -680,16 +773,19 @@ struct TelegramBotInlineQueryResultGif : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the GIF animation
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "gif_url", this->gifUrl);
-        JsonHelperT<qint32>::jsonPathGet(object, "gif_width", this->gifWidth);
-        JsonHelperT<qint32>::jsonPathGet(object, "gif_height", this->gifHeight);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultGif> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "gif_url", gifUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "gif_width", gifWidth, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "gif_height", gifHeight, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "thumb_url", thumbUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGif, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -707,16 +803,19 @@ struct TelegramBotInlineQueryResultMpeg4Gif : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the video animation
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "mpeg4Url", this->mpeg4Url);
-        JsonHelperT<qint32>::jsonPathGet(object, "mpeg4Width", this->mpeg4Width);
-        JsonHelperT<qint32>::jsonPathGet(object, "mpeg4Height", this->mpeg4Height);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultMpeg4Gif> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "mpeg4Url", mpeg4Url, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "mpeg4Width", mpeg4Width, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "mpeg4Height", mpeg4Height, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "thumb_url", thumbUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultMpeg4Gif, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -737,19 +836,22 @@ struct TelegramBotInlineQueryResultVideo : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the video
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "video_url", this->videoUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "video_width", this->videoWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "video_height", this->videoHeight, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "video_duration", this->videoDuration, false);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultVideo> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "video_url", videoUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "mime_type", mimeType, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "thumb_url", thumbUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "video_width", videoWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "video_height", videoHeight, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "video_duration", videoDuration, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVideo, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -766,15 +868,18 @@ struct TelegramBotInlineQueryResultAudio : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the audio (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "audio_url", this->audioUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<QString>::jsonPathGet(object, "performer", this->performer, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "audio_duration", this->audioDuration, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultAudio> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "audio_url", audioUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "performer", performer, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "audio_duration", audioDuration, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultAudio, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -790,14 +895,17 @@ struct TelegramBotInlineQueryResultVoice : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the voice recording (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "voice_url", this->voiceUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "voice_duration", this->voiceDuration, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultVoice> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "voice_url", voiceUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "voice_duration", voiceDuration, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVoice, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -817,18 +925,21 @@ struct TelegramBotInlineQueryResultDocument : public TelegramBotObject {
     qint32 thumbHeight; // Optional. Thumbnail height (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption);
-        JsonHelperT<QString>::jsonPathGet(object, "document_url", this->documentUrl);
-        JsonHelperT<QString>::jsonPathGet(object, "mime_type", this->mimeType);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_width", this->thumbWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_height", this->thumbHeight, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultDocument> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "caption", caption, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "document_url", documentUrl, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "mime_type", mimeType, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "input_message_content", inputMessageContent, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "thumb_url", thumbUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "thumb_width", thumbWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultDocument, "thumb_height", thumbHeight, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -846,16 +957,19 @@ struct TelegramBotInlineQueryResultLocation : public TelegramBotObject {
     qint32 thumbHeight; // Optional. Thumbnail height (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<double>::jsonPathGet(object, "latitude", this->latitude);
-        JsonHelperT<double>::jsonPathGet(object, "longitude", this->longitude);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_width", this->thumbWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_height", this->thumbHeight, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultLocation> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "latitude", latitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "longitude", longitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "input_message_content", inputMessageContent, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "thumb_url", thumbUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "thumb_width", thumbWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultLocation, "thumb_height", thumbHeight, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -875,18 +989,21 @@ struct TelegramBotInlineQueryResultVenue : public TelegramBotObject {
     qint32 thumbHeight; // Optional. Thumbnail height (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<double>::jsonPathGet(object, "latitude", this->latitude);
-        JsonHelperT<double>::jsonPathGet(object, "longitude", this->longitude);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "address", this->address);
-        JsonHelperT<QString>::jsonPathGet(object, "foursquare_id", this->foursquareId, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_width", this->thumbWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_height", this->thumbHeight, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultVenue> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "latitude", latitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "longitude", longitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "address", address, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "foursquare_id", foursquareId, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "input_message_content", inputMessageContent, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "thumb_url", thumbUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "thumb_width", thumbWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultVenue, "thumb_height", thumbHeight, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -904,16 +1021,19 @@ struct TelegramBotInlineQueryResultContact : public TelegramBotObject {
     qint32 thumbHeight; // Optional. Thumbnail height (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "phone_number", this->phoneNumber);
-        JsonHelperT<QString>::jsonPathGet(object, "first_name", this->firstName);
-        JsonHelperT<QString>::jsonPathGet(object, "last_name", this->lastName, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
-        JsonHelperT<QString>::jsonPathGet(object, "thumb_url", this->thumbUrl, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_width", this->thumbWidth, false);
-        JsonHelperT<qint32>::jsonPathGet(object, "thumb_height", this->thumbHeight, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultContact> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "phone_number", phoneNumber, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "first_name", firstName, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "last_name", lastName, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "input_message_content", inputMessageContent, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "thumb_url", thumbUrl, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "thumb_width", thumbWidth, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultContact, "thumb_height", thumbHeight, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -925,10 +1045,13 @@ struct TelegramBotInlineQueryResultGame : public TelegramBotObject {
     TelegramKeyboard replyMarkup; // Optional. Inline keyboard attached to the message (Note: This will only work in Telegram versions released after October 1, 2016. Older clients will not display any inline results if a game result is among them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "game_short_name", this->gameShortName);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultGame> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGame, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGame, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGame, "game_short_name", gameShortName, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultGame, "reply_markup", replyMarkup, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -944,14 +1067,17 @@ struct TelegramBotInlineQueryResultCachedPhoto : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the photo
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "photo_file_id", this->photoFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedPhoto> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "photo_file_id", photoFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedPhoto, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -966,13 +1092,16 @@ struct TelegramBotInlineQueryResultCachedGif : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the GIF animation
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "gif_file_id", this->gifFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedGif> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "gif_file_id", gifFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedGif, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -987,13 +1116,16 @@ struct TelegramBotInlineQueryResultCachedMpeg4Gif : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the video animation
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "mpeg4FileId", this->mpeg4FileId);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedMpeg4Gif> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "mpeg4FileId", mpeg4FileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "title", title, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedMpeg4Gif, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1006,11 +1138,14 @@ struct TelegramBotInlineQueryResultCachedSticker : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the sticker (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "sticker_file_id", this->stickerFileId);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedSticker> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedSticker, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedSticker, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedSticker, "sticker_file_id", stickerFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedSticker, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedSticker, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1026,14 +1161,17 @@ struct TelegramBotInlineQueryResultCachedDocument : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the file (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "document_file_id", this->documentFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedDocument> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "document_file_id", documentFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedDocument, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1049,14 +1187,17 @@ struct TelegramBotInlineQueryResultCachedVideo : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the video
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "video_file_id", this->videoFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "description", this->description, false);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedVideo> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "video_file_id", videoFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "description", description, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVideo, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1071,13 +1212,16 @@ struct TelegramBotInlineQueryResultCachedVoice : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the voice message (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "voice_file_id", this->voiceFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedVoice> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "voice_file_id", voiceFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedVoice, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1091,12 +1235,15 @@ struct TelegramBotInlineQueryResultCachedAudio : public TelegramBotObject {
     TelegramBotInputMessageContent inputMessageContent; // Optional. Content of the message to be sent instead of the audio (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "type", this->type);
-        JsonHelperT<QString>::jsonPathGet(object, "id", this->id);
-        JsonHelperT<QString>::jsonPathGet(object, "audio_file_id", this->audioFileId);
-        JsonHelperT<QString>::jsonPathGet(object, "caption", this->caption, false);
-        JsonHelperT<TelegramBotKeyboardButton>::jsonPathGetArrayArray(object, "reply_markup", this->replyMarkup, false);
-        JsonHelperT<TelegramBotInputMessageContent>::jsonPathGet(object, "input_message_content", this->inputMessageContent, false);
+        static const TelegramBotFieldTable<TelegramBotInlineQueryResultCachedAudio> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "type", type, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "id", id, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "audio_file_id", audioFileId, true),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "caption", caption, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "reply_markup", replyMarkup, false),
+            TELEGRAMBOT_FIELD(TelegramBotInlineQueryResultCachedAudio, "input_message_content", inputMessageContent, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1106,8 +1253,11 @@ struct TelegramBotInputLocationMessageContent : public TelegramBotObject {
     double longitude; // Longitude of the location in degrees (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<double>::jsonPathGet(object, "latitude", this->latitude);
-        JsonHelperT<double>::jsonPathGet(object, "longitude", this->longitude);
+        static const TelegramBotFieldTable<TelegramBotInputLocationMessageContent> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInputLocationMessageContent, "latitude", latitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputLocationMessageContent, "longitude", longitude, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1120,11 +1270,14 @@ struct TelegramBotInputVenueMessageContent : public TelegramBotObject {
     QString foursquareId; // Optional. Foursquare identifier of the venue, if known (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<double>::jsonPathGet(object, "latitude", this->latitude);
-        JsonHelperT<double>::jsonPathGet(object, "longitude", this->longitude);
-        JsonHelperT<QString>::jsonPathGet(object, "title", this->title);
-        JsonHelperT<QString>::jsonPathGet(object, "address", this->address);
-        JsonHelperT<QString>::jsonPathGet(object, "foursquare_id", this->foursquareId, false);
+        static const TelegramBotFieldTable<TelegramBotInputVenueMessageContent> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInputVenueMessageContent, "latitude", latitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputVenueMessageContent, "longitude", longitude, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputVenueMessageContent, "title", title, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputVenueMessageContent, "address", address, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputVenueMessageContent, "foursquare_id", foursquareId, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1135,9 +1288,12 @@ struct TelegramBotInputContactMessageContent : public TelegramBotObject {
     QString lastName; // Optional. Contact's last name (Note: This will only work in Telegram versions released after 9 April, 2016. Older clients will ignore them.)
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "phone_number", this->phoneNumber);
-        JsonHelperT<QString>::jsonPathGet(object, "first_name", this->firstName);
-        JsonHelperT<QString>::jsonPathGet(object, "last_name", this->lastName, false);
+        static const TelegramBotFieldTable<TelegramBotInputContactMessageContent> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotInputContactMessageContent, "phone_number", phoneNumber, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputContactMessageContent, "first_name", firstName, true),
+            TELEGRAMBOT_FIELD(TelegramBotInputContactMessageContent, "last_name", lastName, false)
+        };
+        fields.parse(*this, object);
     }
 };
 
@@ -1150,15 +1306,19 @@ struct TelegramBotChosenInlineResult : public TelegramBotObject {
     QString query; // The query that was used to obtain the result
 
     virtual void fromJson(QJsonObject& object) {
-        JsonHelperT<QString>::jsonPathGet(object, "result_id", this->resultId);
-        JsonHelperT<TelegramBotUser>::jsonPathGet(object, "from", this->from);
-        JsonHelperT<TelegramBotLocation>::jsonPathGet(object, "location", this->location, false);
-        JsonHelperT<QString>::jsonPathGet(object, "inline_message_id", this->inlineMessageId, false);
-        JsonHelperT<QString>::jsonPathGet(object, "query", this->query);
+        static const TelegramBotFieldTable<TelegramBotChosenInlineResult> fields = {
+            TELEGRAMBOT_FIELD(TelegramBotChosenInlineResult, "result_id", resultId, true),
+            TELEGRAMBOT_FIELD(TelegramBotChosenInlineResult, "from", from, true),
+            TELEGRAMBOT_FIELD(TelegramBotChosenInlineResult, "location", location, false),
+            TELEGRAMBOT_FIELD(TelegramBotChosenInlineResult, "inline_message_id", inlineMessageId, false),
+            TELEGRAMBOT_FIELD(TelegramBotChosenInlineResult, "query", query, true)
+        };
+        fields.parse(*this, object);
     }
 };
 
 // This object represents an incoming update.
+// Note: the update objects are parsed on their first access, so handlers only pay for the objects they use
 struct TelegramBotUpdatePrivate : public TelegramBotObject {
     TelegramBotMessageType type = Undefined;
     int updateId;
@@ -1166,17 +1326,20 @@ struct TelegramBotUpdatePrivate : public TelegramBotObject {
 	// Contains the message for the following Update types:
 	// Message, EditedMessage, ChannelPost, EditedChannelPost, CallbackQuery
 	// Special Case: points also to the Message of a CallbackQuery!
-    TelegramBotMessage*             message = 0;
-    TelegramBotInlineQuery*         inlineQuery = 0;
-    TelegramBotChosenInlineResult*  chosenInlineResult = 0;
-    TelegramBotCallbackQuery*       callbackQuery = 0;
-
-    virtual ~TelegramBotUpdatePrivate()
-    {
-        if(!this->callbackQuery) delete this->message;
-        delete this->inlineQuery;
-        delete this->chosenInlineResult;
-        delete this->callbackQuery;
+    TelegramBotLazyObject<TelegramBotMessage>               message;
+    TelegramBotLazyObject<TelegramBotInlineQuery>          inlineQuery;
+    TelegramBotLazyObject<TelegramBotChosenInlineResult>   chosenInlineResult;
+    TelegramBotLazyObject<TelegramBotCallbackQuery>        callbackQuery;
+
+    // shortcuts for the most used fields, they are read from the raw json, so no object is parsed
+    QString text() { return this->message.json().value("text").toString(); }
+    qint64 chatId() { return this->message.json().value("chat").toObject().value("id").toVariant().toLongLong(); }
+    qint64 fromId() {
+        const QJsonObject& object = this->inlineQuery ? this->inlineQuery.json() :
+                                    this->chosenInlineResult ? this->chosenInlineResult.json() :
+                                    this->callbackQuery ? this->callbackQuery.json() :
+                                                          this->message.json();
+        return object.value("from").toObject().value("id").toVariant().toLongLong();
     }
 
     virtual void fromJson(QJsonObject& object) {
@@ -1200,27 +1363,27 @@ struct TelegramBotUpdatePrivate : public TelegramBotObject {
             // simplify object
             QJsonObject oMessage = itr.value().toObject();
 
-            // parse Message types
+            // keep Message types
             if(this->type == Message ||
                this->type == EditedMessage ||
                this->type == ChannelPost ||
                this->type == EditedChannelPost)
             {
-                (this->message = new TelegramBotMessage)->fromJson(oMessage);
+                this->message.setJson(oMessage);
             }
 
-            // parse InlineQuery
-            else if(this->type == InlineQuery) (this->inlineQuery = new TelegramBotInlineQuery)->fromJson(oMessage);
-
-            // parse ChosenInlineResult
-            else if(this->type == ChosenInlineResult) (this->chosenInlineResult = new TelegramBotChosenInlineResult)->fromJson(oMessage);
+            // keep InlineQuery
+            else if(this->type == InlineQuery) this->inlineQuery.setJson(oMessage);
 
-            // parse TelegramBotCallbackQuery
-            else if(this->type == CallbackQuery) (this->callbackQuery = new TelegramBotCallbackQuery)->fromJson(oMessage);
+            // keep ChosenInlineResult
+            else if(this->type == ChosenInlineResult) this->chosenInlineResult.setJson(oMessage);
 
-            /// some additional object simplifications
-            // if we have an callbackQuery set message to callbackQuery's message
-            if(this->callbackQuery) this->message = &this->callbackQuery->message;
+            // keep TelegramBotCallbackQuery
+            // Note: if we have an callbackQuery, message is the callbackQuery's message
+            else if(this->type == CallbackQuery) {
+                this->callbackQuery.setJson(oMessage);
+                this->message.setJson(oMessage.value("message").toObject(), this->callbackQuery, &TelegramBotCallbackQuery::message);
+            }
         }
     }
 };
@@ -2,11 +2,13 @@ QT += core network
 CONFIG += c++14
 
 SOURCES +=	$$PWD/src/telegrambot.cpp \
+			$$PWD/src/telegrambotoffsetstore.cpp \
 			$$PWD/src/jsonhelper.cpp \
 			$$PWD/modules/sslserver/sslserver.cpp \
 			$$PWD/modules/httpserver/httpserver.cpp
 
 HEADERS +=	$$PWD/src/telegrambot.h \
+			$$PWD/src/telegrambotoffsetstore.h \
 			$$PWD/src/jsonhelper.h \
 			$$PWD/src/telegramdatastructs.h \
 			$$PWD/src/telegramdatainterface.h \
@@ -17,5 +19,16 @@ INCLUDEPATH += $$PWD/src/
 INCLUDEPATH += $$PWD/modules/sslserver/
 INCLUDEPATH += $$PWD/modules/httpserver/
 
+#request tracing (CONFIG += telegrambot_trace), otherwise the tracing code is compiled out
+telegrambot_trace: DEFINES += TELEGRAMBOT_TRACE
+
+#simd json decoder for api answers (CONFIG += telegrambot_simdjson), otherwise QJsonDocument is used
+#Note: AVX2 and SSE4.2 are detected at runtime on x86 with gcc and clang, other platforms use the scalar fallback
+telegrambot_simdjson {
+    DEFINES += TELEGRAMBOT_SIMDJSON
+    SOURCES += $$PWD/src/jsondecoder.cpp
+    HEADERS += $$PWD/src/jsondecoder.h
+}
+
 #include QDelegate dependency
 include($$PWD/vendor/qdelegate/QDelegate.pri)